@@ -0,0 +1,707 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	Benchmark.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	Benchmark
+// Description:
+//		Static helpers which time whole frames of tasks on temporary thread
+//		pools and print the results to the console.
+//
+
+//Self Include
+#include "Benchmark.h"
+
+//Library Includes
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+//Local Includes
+#include "ExecutorADT.h"
+#include "CostMap.h"
+
+//	RunContention( _tasks, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Times the provided frame of tasks on every queue type, doubling the
+//		thread count from 1 up to the hardware concurrency, and prints the
+//		average frame time of each combination.
+//
+//	Param:
+//		- std::vector<CTask>&	|	Tasks which make up one frame.
+//		- unsigned int			|	Frames to average over.
+//
+//	Return: n/a		|
+//
+void Benchmark::RunContention(const std::vector<CTask>& _tasks, unsigned int _frames)
+{
+	const QueueType types[] = { QUEUE_SHARED, QUEUE_STEALING, QUEUE_RING, QUEUE_PRIORITY };
+	const unsigned int typeCount = sizeof(types) / sizeof(QueueType);
+
+	//Thread counts to test: 1, 2, 4 ... hardware concurrency
+	std::vector<unsigned int> counts;
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0)
+	{
+		maxThreads = 1;
+	}
+	for (unsigned int count = 1; count < maxThreads; count *= 2)
+	{
+		counts.push_back(count);
+	}
+	counts.push_back(maxThreads);
+
+	std::cout << "[BENCHMARK]: Queue contention, " << _tasks.size() << " tasks per frame, " << _frames << " frames." << std::endl;
+	std::cout << "[BENCHMARK]: " << std::setw(8) << "Threads";
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		std::cout << std::setw(12) << ThreadPool::QueueTypeToString(types[t]);
+	}
+	std::cout << "   (ms per frame)" << std::endl;
+
+	for (unsigned int c = 0; c < counts.size(); c++)
+	{
+		std::cout << "[BENCHMARK]: " << std::setw(8) << counts[c];
+		for (unsigned int t = 0; t < typeCount; t++)
+		{
+			ThreadPoolConfig config;
+			config.m_uiThreadCount = counts[c];
+			config.m_eQueueType = types[t];
+			config.m_bLogWorkers = false;
+
+			ThreadPool* pool = new ThreadPool(config);
+			pool->Initialize();
+			pool->Start();
+
+			//Warm up once so thread start up isn't measured
+			TimeFrames(*pool, _tasks, 1);
+			double ms = TimeFrames(*pool, _tasks, _frames);
+
+			delete pool;
+
+			std::cout << std::setw(12) << std::fixed << std::setprecision(3) << ms;
+		}
+		std::cout << std::endl;
+	}
+}
+
+//	RunAffinity( _tasks, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Times the provided frame of tasks with unpinned workers, one worker per
+//		core (with and without SMT siblings) and one NUMA node per worker.
+//		Uses the thread count and queue type of the running pool.
+//
+//	Param:
+//		- std::vector<CTask>&	|	Tasks which make up one frame.
+//		- unsigned int			|	Frames to average over.
+//
+//	Return: n/a		|
+//
+void Benchmark::RunAffinity(const std::vector<CTask>& _tasks, unsigned int _frames)
+{
+	const AffinityMode modes[] = { AFFINITY_NONE, AFFINITY_CORE, AFFINITY_CORE, AFFINITY_NODE };
+	const bool skipSMT[] = { false, false, true, false };
+	const unsigned int modeCount = sizeof(modes) / sizeof(AffinityMode);
+
+	//Same settings as the running pool, apart from the affinity
+	ThreadPoolConfig config = ThreadPool::GetInstance().GetConfig();
+	config.m_uiThreadCount = ThreadPool::GetInstance().GetWorkerCount();
+	config.m_uiTraceCapacity = 0;
+	config.m_bLogWorkers = false;
+
+	std::cout << "[BENCHMARK]: Worker affinity, " << config.m_uiThreadCount << " " << ThreadPool::QueueTypeToString(config.m_eQueueType) << " workers, ";
+	std::cout << _tasks.size() << " tasks per frame, " << _frames << " frames." << std::endl;
+
+	double unpinned = 0.0;
+	for (unsigned int m = 0; m < modeCount; m++)
+	{
+		config.m_eAffinity = modes[m];
+		config.m_bSkipSMT = skipSMT[m];
+
+		ThreadPool* pool = new ThreadPool(config);
+		pool->Initialize();
+		pool->Start();
+
+		//Warm up once so thread start up isn't measured
+		TimeFrames(*pool, _tasks, 1);
+		double ms = TimeFrames(*pool, _tasks, _frames);
+
+		delete pool;
+
+		if (m == 0)
+		{
+			unpinned = ms;
+		}
+
+		std::string name = CpuAffinity::ModeToString(modes[m]) + (skipSMT[m] ? " (no SMT)" : "");
+		std::cout << "[BENCHMARK]: " << std::setw(16) << name << std::setw(12) << std::fixed << std::setprecision(3) << ms << " ms per frame";
+		std::cout << std::setw(10) << std::setprecision(2) << ((ms > 0.0) ? unpinned / ms : 0.0) << "x" << std::endl;
+	}
+}
+
+//	RunWakeLatency( _samples, _gapMicroseconds )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Measures the time from submitting a task to a worker starting it, for
+//		several idle policies. Each sample submits one empty task after the
+//		workers have been idle for the gap. Start times come from the task
+//		trace, so the measurement adds nothing to the worker's path.
+//
+//	Param:
+//		- unsigned int	|	Tasks to submit per policy.
+//		- unsigned int	|	Idle time before each task, in microseconds.
+//
+//	Return: n/a		|
+//
+void Benchmark::RunWakeLatency(unsigned int _samples, unsigned int _gapMicroseconds)
+{
+	const char* names[] = { "Park", "Yield", "Spin", "Spin long" };
+	const unsigned int spins[] = { 0, 0, 1000, 100000 };
+	const unsigned int yields[] = { 0, 64, 8, 8 };
+	const unsigned int policyCount = sizeof(spins) / sizeof(unsigned int);
+
+	if (_samples == 0)
+	{
+		return;
+	}
+
+	ThreadPoolConfig config = ThreadPool::GetInstance().GetConfig();
+	config.m_uiThreadCount = ThreadPool::GetInstance().GetWorkerCount();
+	config.m_uiTraceCapacity = _samples;
+	config.m_uiRetireMilliseconds = 0;
+	config.m_bLogWorkers = false;
+	unsigned int threads = config.m_uiThreadCount;
+
+	std::cout << "[BENCHMARK]: Wake latency, " << threads << " " << ThreadPool::QueueTypeToString(config.m_eQueueType) << " workers, ";
+	std::cout << _samples << " samples, " << _gapMicroseconds << "us idle before each." << std::endl;
+	std::cout << "[BENCHMARK]: " << std::setw(16) << "Policy" << std::setw(12) << "Median" << std::setw(12) << "P99" << std::setw(12) << "Max" << "   (us)" << std::endl;
+
+	for (unsigned int p = 0; p < policyCount; p++)
+	{
+		config.m_uiIdleSpinCount = spins[p];
+		config.m_uiIdleYieldCount = yields[p];
+
+		ThreadPool* pool = new ThreadPool(config);
+		pool->Initialize();
+		pool->Start();
+
+		std::vector<uint64_t> submitted(_samples);
+		for (unsigned int i = 0; i < _samples; i++)
+		{
+			//Busy wait the gap, sleeping is far too coarse on some platforms
+			std::chrono::steady_clock::time_point until = std::chrono::steady_clock::now() + std::chrono::microseconds(_gapMicroseconds);
+			while (std::chrono::steady_clock::now() < until)
+			{
+				CpuRelax();
+			}
+
+			submitted[i] = TaskTracer::ReadTimestamp();
+			pool->Submit(CTask()).Wait();
+		}
+
+		//Samples ran one at a time, so in start order they match the submits
+		std::vector<TraceEvent> events;
+		for (unsigned int i = 0; i < threads; i++)
+		{
+			pool->m_pTracer->GetRing(i).Collect(events);
+		}
+		std::sort(events.begin(), events.end(), [](const TraceEvent& _a, const TraceEvent& _b) { return _a.m_ulStart < _b.m_ulStart; });
+
+		double ticksPerMicro = pool->m_pTracer->GetTicksPerMicrosecond();
+		std::vector<double> latency;
+		for (size_t i = 0; i < events.size() && i < submitted.size(); i++)
+		{
+			latency.push_back(static_cast<int64_t>(events[i].m_ulStart - submitted[i]) / ticksPerMicro);
+		}
+
+		delete pool;
+
+		if (latency.empty())
+		{
+			continue;
+		}
+		std::sort(latency.begin(), latency.end());
+
+		std::cout << "[BENCHMARK]: " << std::setw(16) << names[p] << std::fixed << std::setprecision(1);
+		std::cout << std::setw(12) << latency[latency.size() / 2];
+		std::cout << std::setw(12) << latency[(latency.size() * 99) / 100];
+		std::cout << std::setw(12) << latency.back() << std::endl;
+	}
+}
+
+//	RunQoS( _tasks, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Times frames of _tasks on an idle pool, then while a higher
+//		resolution copy of the view keeps every worker busy, first queued as
+//		background work and then as interactive work. With the load in the
+//		background class the frame time should stay close to the idle one.
+//
+//	Param:
+//		- std::vector<CTask>&	|	One frame worth of tasks.
+//		- unsigned int			|	Number of frames to time.
+//
+//	Return: n/a		|
+//
+void Benchmark::RunQoS(const std::vector<CTask>& _tasks, unsigned int _frames)
+{
+	RenderJob* view = _tasks.empty() ? nullptr : _tasks[0].GetJob();
+	if (view == nullptr || _tasks[0].GetSizeX() == 0)
+	{
+		return;
+	}
+
+	//Same settings as the running pool
+	ThreadPoolConfig config = ThreadPool::GetInstance().GetConfig();
+	config.m_uiThreadCount = ThreadPool::GetInstance().GetWorkerCount();
+	config.m_uiTraceCapacity = 0;
+	config.m_bLogWorkers = false;
+
+	//The load is the view at twice the resolution, in tiles of the same size
+	RenderJob background(view->GetWidth() * 2, view->GetHeight() * 2, view->GetIterationLimit());
+	background.SetView(view->GetLeft(), view->GetTop(), view->GetPixelWidth() / 2.0f, view->GetPixelHeight() / 2.0f);
+	background.ResetPixels(background.GetBounds());
+
+	std::vector<CTask> tiles;
+	background.CreateTasks(2 * view->GetWidth() / _tasks[0].GetSizeX(), tiles);
+
+	//Each copy is about four frames of work, queue enough to outlast the
+	//timed frames
+	size_t copies = _frames / 2 + 1;
+	std::vector<CTask> load;
+	for (size_t i = 0; i < copies; i++)
+	{
+		load.insert(load.end(), tiles.begin(), tiles.end());
+	}
+
+	//A bounded queue would make the submit wait for room before the
+	//timing starts, so only queue as much as fits
+	if (config.m_uiMaxQueued > 0 && load.size() > config.m_uiMaxQueued)
+	{
+		load.erase(load.begin() + config.m_uiMaxQueued, load.end());
+	}
+
+	std::cout << "[BENCHMARK]: Interactive frames under load, " << config.m_uiThreadCount << " " << ThreadPool::QueueTypeToString(config.m_eQueueType) << " workers, ";
+	std::cout << _tasks.size() << " tasks per frame, " << load.size() << " load tasks, " << _frames << " frames." << std::endl;
+
+	const char* names[] = { "Idle", "Background load", "Same class load" };
+	double idle = 0.0;
+	for (unsigned int m = 0; m < 3; m++)
+	{
+		ThreadPool* pool = new ThreadPool(config);
+		pool->Initialize();
+		pool->Start();
+
+		//Warm up once so thread start up isn't measured
+		TimeFrames(*pool, _tasks, 1);
+
+		std::shared_ptr<TaskGroup> loadGroup = std::make_shared<TaskGroup>();
+		size_t loadCount = 0;
+		if (m > 0)
+		{
+			loadGroup->SetQoS((m == 1) ? QOS_BACKGROUND : QOS_INTERACTIVE);
+			std::vector<CTask> tasks(load);
+			pool->SubmitBatch(tasks.data(), tasks.size(), loadGroup);
+			loadCount = tasks.size();
+		}
+
+		double ms = TimeFrames(*pool, _tasks, _frames);
+
+		//Whatever load is left over isn't needed
+		loadGroup->Cancel();
+		loadGroup->Wait();
+		uint64_t loadRun = loadCount - loadGroup->GetTasksDropped();
+
+		delete pool;
+
+		if (m == 0)
+		{
+			idle = ms;
+		}
+
+		std::cout << "[BENCHMARK]: " << std::setw(16) << names[m] << std::setw(12) << std::fixed << std::setprecision(3) << ms << " ms per frame";
+		std::cout << std::setw(10) << std::setprecision(2) << ((idle > 0.0) ? ms / idle : 0.0) << "x idle";
+		std::cout << std::setw(8) << loadRun << " load tasks run" << std::endl;
+	}
+}
+
+//	RunExecutors( _view, _divisions, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Times frames of the same tiles on every executor backend and checks
+//		each one's output is bit for bit the same as the pool's. The pool
+//		backend runs on the default ThreadPool instance.
+//
+//	Param:
+//		- RenderJob&	|	View to compute, its pixels and output are overwritten.
+//		- int			|	Number of divisions along each axis.
+//		- unsigned int	|	Number of frames to time.
+//
+//	Return: bool	|	True if every backend gave the same output.
+//
+bool Benchmark::RunExecutors(RenderJob& _view, int _divisions, unsigned int _frames)
+{
+	const ExecutorType types[] = { EXECUTOR_POOL, EXECUTOR_DISPENSER, EXECUTOR_OPENMP, EXECUTOR_PARALLEL_STL };
+	const unsigned int typeCount = sizeof(types) / sizeof(ExecutorType);
+
+	std::vector<CTask> tiles;
+	_view.CreateTasks(_divisions, tiles);
+	const size_t bytes = static_cast<size_t>(_view.GetWidth()) * _view.GetHeight() * 4;
+
+	std::cout << "[BENCHMARK]: Executors, " << ThreadPool::GetInstance().GetWorkerCount() << " pool workers, " << std::thread::hardware_concurrency() << " hardware threads, ";
+	std::cout << tiles.size() << " tiles per frame, " << _frames << " frames." << std::endl;
+
+	std::vector<unsigned char> reference;
+	double poolMs = 0.0;
+	bool allMatch = true;
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		ExecutorADT* executor = ExecutorADT::Create(types[t]);
+		double ms = TimeExecutor(*executor, _view, tiles, _frames);
+		delete executor;
+
+		bool match = true;
+		if (t == 0)
+		{
+			reference.assign(_view.GetOutput(), _view.GetOutput() + bytes);
+			poolMs = ms;
+		}
+		else
+		{
+			match = std::equal(reference.begin(), reference.end(), _view.GetOutput());
+			allMatch = allMatch && match;
+		}
+
+		std::cout << "[BENCHMARK]: " << std::setw(16) << ExecutorADT::TypeToString(types[t]) << std::setw(12) << std::fixed << std::setprecision(3) << ms << " ms per frame";
+		std::cout << std::setw(10) << std::setprecision(2) << ((ms > 0.0) ? poolMs / ms : 0.0) << "x";
+		std::cout << ((match) ? "   output identical" : "   OUTPUT DIFFERS") << std::endl;
+	}
+	return allMatch;
+}
+
+//	RunTileSizes( _view, _divisions, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Times the queue based pool backend against the tile dispenser on
+//		the WorkDivisionsCount grid and on exact tilings of several sizes,
+//		including the largest square tiles which fit a 32KB L1 and a 256KB
+//		L2 cache. Checks every run's output against the grid on the pool.
+//
+//	Param:
+//		- RenderJob&	|	View to compute, its pixels and output are overwritten.
+//		- int			|	Number of divisions along each axis for the grid.
+//		- unsigned int	|	Number of frames to time.
+//
+//	Return: bool	|	True if every run gave the same output.
+//
+bool Benchmark::RunTileSizes(RenderJob& _view, int _divisions, unsigned int _frames)
+{
+	const ExecutorType types[] = { EXECUTOR_POOL, EXECUTOR_DISPENSER };
+	const unsigned int typeCount = sizeof(types) / sizeof(ExecutorType);
+	const size_t bytes = static_cast<size_t>(_view.GetWidth()) * _view.GetHeight() * 4;
+
+	//Square tile sides to try, 0 stands for the grid
+	const int l1 = RenderJob::GetTileSideForCache(32 * 1024);
+	const int l2 = RenderJob::GetTileSideForCache(256 * 1024);
+	std::vector<int> sides = { 0, 16, 32, l1, 64, 128, l2, 256 };
+	std::sort(sides.begin(), sides.end());
+	sides.erase(std::unique(sides.begin(), sides.end()), sides.end());
+
+	std::cout << "[BENCHMARK]: Tile sizes, " << ThreadPool::GetInstance().GetWorkerCount() << " pool workers, " << _frames << " frames, ";
+	std::cout << "L1 tile " << l1 << ", L2 tile " << l2 << "." << std::endl;
+	std::cout << "[BENCHMARK]: " << std::setw(10) << "Tile" << std::setw(8) << "Tiles";
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		std::cout << std::setw(12) << ExecutorADT::TypeToString(types[t]);
+	}
+	std::cout << "   (ms per frame)" << std::endl;
+
+	ExecutorADT* executors[typeCount];
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		executors[t] = ExecutorADT::Create(types[t]);
+	}
+
+	std::vector<unsigned char> reference;
+	bool allMatch = true;
+	for (size_t s = 0; s < sides.size(); s++)
+	{
+		std::vector<CTask> tiles;
+		std::string name;
+		if (sides[s] == 0)
+		{
+			_view.CreateTasks(_divisions, tiles);
+			name = "Grid";
+		}
+		else
+		{
+			_view.CreateTiles(sides[s], sides[s], tiles);
+			name = std::to_string(sides[s]) + "x" + std::to_string(sides[s]);
+		}
+
+		std::cout << "[BENCHMARK]: " << std::setw(10) << name << std::setw(8) << tiles.size();
+		bool match = true;
+		for (unsigned int t = 0; t < typeCount; t++)
+		{
+			double ms = TimeExecutor(*executors[t], _view, tiles, _frames);
+			if (reference.empty())
+			{
+				reference.assign(_view.GetOutput(), _view.GetOutput() + bytes);
+			}
+			match = match && std::equal(reference.begin(), reference.end(), _view.GetOutput());
+
+			std::cout << std::setw(12) << std::fixed << std::setprecision(3) << ms;
+		}
+		allMatch = allMatch && match;
+		std::cout << ((match) ? "" : "   OUTPUT DIFFERS") << std::endl;
+	}
+
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		delete executors[t];
+	}
+	return allMatch;
+}
+
+//	RunCostMap( _view, _divisions, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Records what the view costs, pans it an eighth of its width and
+//		moves the costs across, as an interactive session would. Then times
+//		the new view as a plain grid, as the same grid longest first and as
+//		cost balanced tiles longest first, all on the pool backend. Prints
+//		each makespan against the plain grid's and checks the outputs match.
+//		The view is put back afterwards, its pixels are overwritten.
+//
+//	Param:
+//		- RenderJob&	|	View to compute.
+//		- int			|	Number of divisions along each axis.
+//		- unsigned int	|	Number of frames to time.
+//
+//	Return: bool	|	True if every schedule gave the same output.
+//
+bool Benchmark::RunCostMap(RenderJob& _view, int _divisions, unsigned int _frames)
+{
+	const float left = _view.GetLeft();
+	const float top = _view.GetTop();
+	const size_t bytes = static_cast<size_t>(_view.GetWidth()) * _view.GetHeight() * 4;
+	ExecutorADT* executor = ExecutorADT::Create(EXECUTOR_POOL);
+
+	//One frame of the starting view fills the map
+	CostMap costMap;
+	costMap.Reproject(_view);
+	_view.SetCostMap(&costMap);
+	std::vector<CTask> tiles;
+	_view.CreateTasks(_divisions, tiles);
+	TimeExecutor(*executor, _view, tiles, 0);
+	_view.SetCostMap(nullptr);
+
+	_view.SetView(left + _view.GetWidth() / 8 * _view.GetPixelWidth(), top, _view.GetPixelWidth(), _view.GetPixelHeight());
+	costMap.Reproject(_view);
+
+	const char* names[] = { "Grid", "Grid LPT", "Balanced LPT" };
+	std::vector<CTask> schedules[3];
+	_view.CreateTasks(_divisions, schedules[0]);
+	schedules[1] = schedules[0];
+	costMap.CreateBalancedTiles(_view, _divisions * _divisions, schedules[2]);
+
+	PriorityFunction longestFirst = costMap.LongestFirst();
+	for (unsigned int s = 1; s < 3; s++)
+	{
+		for (size_t i = 0; i < schedules[s].size(); i++)
+		{
+			schedules[s][i].SetPriority(longestFirst(schedules[s][i]));
+		}
+		std::stable_sort(schedules[s].begin(), schedules[s].end(), [](const CTask& _a, const CTask& _b) { return _a.GetPriority() < _b.GetPriority(); });
+	}
+
+	double predicted = costMap.Estimate(_view.GetBounds());
+	std::cout << "[BENCHMARK]: Cost map LPT, " << ThreadPool::GetInstance().GetWorkerCount() << " pool workers, view panned by " << _view.GetWidth() / 8 << " pixels, ";
+	std::cout << static_cast<uint64_t>(predicted) << " iterations predicted, " << _frames << " frames." << std::endl;
+	std::cout << "[BENCHMARK]: " << std::setw(16) << "Schedule" << std::setw(8) << "Tiles" << std::setw(12) << "Makespan" << std::setw(11) << "vs Grid" << std::setw(14) << "Longest tile" << std::endl;
+
+	std::vector<unsigned char> reference;
+	double gridMs = 0.0;
+	bool allMatch = true;
+	for (unsigned int s = 0; s < 3; s++)
+	{
+		double ms = TimeExecutor(*executor, _view, schedules[s], _frames);
+
+		bool match = true;
+		if (s == 0)
+		{
+			reference.assign(_view.GetOutput(), _view.GetOutput() + bytes);
+			gridMs = ms;
+		}
+		else
+		{
+			match = std::equal(reference.begin(), reference.end(), _view.GetOutput());
+			allMatch = allMatch && match;
+		}
+
+		//No schedule finishes before its costliest tile does
+		double longest = 0.0;
+		for (size_t i = 0; i < schedules[s].size(); i++)
+		{
+			longest = std::max(longest, costMap.Estimate(schedules[s][i].GetRange()));
+		}
+
+		std::cout << "[BENCHMARK]: " << std::setw(16) << names[s] << std::setw(8) << schedules[s].size() << std::setw(9) << std::fixed << std::setprecision(3) << ms << " ms";
+		std::cout << std::setw(10) << std::setprecision(2) << ((ms > 0.0) ? gridMs / ms : 0.0) << "x";
+		std::cout << std::setw(13) << std::setprecision(1) << ((predicted > 0.0) ? 100.0 * longest / predicted : 0.0) << "%";
+		std::cout << ((match) ? "" : "   OUTPUT DIFFERS") << std::endl;
+	}
+
+	delete executor;
+	_view.SetView(left, top, _view.GetPixelWidth(), _view.GetPixelHeight());
+	return allMatch;
+}
+
+//	RunAllocations( _view, _divisions, _frames )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Runs frames of the view on the backends which queue CFunctionTasks
+//		and counts the task heap allocations each frame makes. Once the
+//		block pool is warmed up, a frame should make none.
+//
+//	Param:
+//		- RenderJob&	|	View to compute, its pixels and output are overwritten.
+//		- int			|	Number of divisions along each axis.
+//		- unsigned int	|	Number of frames to count.
+//
+//	Return: bool	|	True if no warmed up frame made a heap allocation.
+//
+bool Benchmark::RunAllocations(RenderJob& _view, int _divisions, unsigned int _frames)
+{
+	const ExecutorType types[] = { EXECUTOR_POOL, EXECUTOR_DISPENSER };
+	const unsigned int typeCount = sizeof(types) / sizeof(ExecutorType);
+
+	std::vector<CTask> tiles;
+	_view.CreateTasks(_divisions, tiles);
+
+	std::cout << "[BENCHMARK]: Task heap allocations, " << tiles.size() << " tiles per frame, " << _frames << " frames after warming up." << std::endl;
+
+	bool none = true;
+	for (unsigned int t = 0; t < typeCount; t++)
+	{
+		ExecutorADT* executor = ExecutorADT::Create(types[t]);
+
+		//The first frames fill the block pool's free lists
+		TimeExecutor(*executor, _view, tiles, 1);
+
+		uint64_t total = 0;
+		uint64_t most = 0;
+		std::vector<CTask> frame;
+		for (unsigned int f = 0; f < _frames; f++)
+		{
+			frame = tiles;
+			uint64_t before = CFunctionTask::GetHeapAllocations();
+			executor->Dispatch(&_view, frame, std::make_shared<TaskGroup>()).Wait();
+			uint64_t made = CFunctionTask::GetHeapAllocations() - before;
+
+			total += made;
+			most = std::max(most, made);
+		}
+		delete executor;
+
+		none = none && (total == 0);
+		std::cout << "[BENCHMARK]: " << std::setw(16) << ExecutorADT::TypeToString(types[t]) << std::setw(8) << total << " in total" << std::setw(8) << most << " most in a frame";
+		std::cout << ((total == 0) ? "" : "   ALLOCATED") << std::endl;
+	}
+	return none;
+}
+
+//	TimeExecutor( _executor, _view, _tiles, _frames )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Resets the view then dispatches the tiles on the backend and waits
+//		for them, once to warm up and then _frames times in a row.
+//
+//	Param:
+//		- ExecutorADT&			|	Backend to run the tiles on.
+//		- RenderJob&			|	View the tiles belong to.
+//		- std::vector<CTask>&	|	Tiles which make up one frame.
+//		- unsigned int			|	Frames to average over.
+//
+//	Return: double	|	Average milliseconds per frame.
+//
+double Benchmark::TimeExecutor(ExecutorADT& _executor, RenderJob& _view, const std::vector<CTask>& _tiles, unsigned int _frames)
+{
+	//Every run starts from the same pixels
+	const size_t bytes = static_cast<size_t>(_view.GetWidth()) * _view.GetHeight() * 4;
+	_view.ResetPixels(_view.GetBounds());
+	std::fill(_view.GetOutput(), _view.GetOutput() + bytes, static_cast<unsigned char>(0));
+
+	//Warm up once so thread start up isn't measured
+	std::vector<CTask> frame(_tiles);
+	_executor.Dispatch(&_view, frame, std::make_shared<TaskGroup>()).Wait();
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	for (unsigned int f = 0; f < _frames; f++)
+	{
+		frame = _tiles;
+		_executor.Dispatch(&_view, frame, std::make_shared<TaskGroup>()).Wait();
+	}
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+	return (_frames > 0) ? (std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0) / _frames : 0.0;
+}
+
+//	TimeFrames( _pool, _tasks, _frames )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Submits the frame of tasks to the pool and waits for it to finish,
+//		_frames times in a row.
+//
+//	Param:
+//		- ThreadPool&			|	Started pool to run the tasks on.
+//		- std::vector<CTask>&	|	Tasks which make up one frame.
+//		- unsigned int			|	Frames to average over.
+//
+//	Return: double	|	Average milliseconds per frame.
+//
+double Benchmark::TimeFrames(ThreadPool& _pool, const std::vector<CTask>& _tasks, unsigned int _frames)
+{
+	if (_frames == 0)
+	{
+		return 0.0;
+	}
+
+	std::vector<CTask> tasks(_tasks);
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (unsigned int f = 0; f < _frames; f++)
+	{
+		_pool.SubmitBatch(tasks.data(), tasks.size()).Wait();
+	}
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	auto time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	return (time / 1000.0) / _frames;
+}
@@ -0,0 +1,47 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	Benchmark.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	Benchmark
+// Description:
+//		Static helpers which time whole frames of tasks on temporary thread
+//		pools and print the results to the console.
+//
+
+//Library Includes
+#include <vector>
+
+//Local Includes
+#include "ThreadPool.h"
+#include "Task.h"
+
+//Forward Declaration
+class ExecutorADT;
+
+class Benchmark
+{
+	//Static Functions:
+public:
+	static void RunContention(const std::vector<CTask>& _tasks, unsigned int _frames = 10);
+	static void RunAffinity(const std::vector<CTask>& _tasks, unsigned int _frames = 10);
+	static void RunWakeLatency(unsigned int _samples = 200, unsigned int _gapMicroseconds = 100);
+	static void RunQoS(const std::vector<CTask>& _tasks, unsigned int _frames = 10);
+	static bool RunExecutors(RenderJob& _view, int _divisions, unsigned int _frames = 10);
+	static bool RunTileSizes(RenderJob& _view, int _divisions, unsigned int _frames = 10);
+	static bool RunCostMap(RenderJob& _view, int _divisions, unsigned int _frames = 10);
+	static bool RunAllocations(RenderJob& _view, int _divisions, unsigned int _frames = 10);
+
+protected:
+	static double TimeFrames(ThreadPool& _pool, const std::vector<CTask>& _tasks, unsigned int _frames);
+	static double TimeExecutor(ExecutorADT& _executor, RenderJob& _view, const std::vector<CTask>& _tiles, unsigned int _frames);
+
+private:
+	Benchmark();
+	~Benchmark();
+};
+
+#endif // !__BENCHMARK_H__
@@ -0,0 +1,126 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	BlockPool.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CBlockPool
+// Description:
+//		Process wide pool of memory blocks in a few fixed size classes. Freed
+//		blocks go onto a free list for their size and are handed out again,
+//		so code which allocates the same sizes every frame stops touching the
+//		heap once it has warmed up. Used for oversized task callables and
+//		coroutine frames.
+//
+
+//Self Include
+#include "BlockPool.h"
+
+//Library Includes
+#include <mutex>
+#include <new>
+#include <vector>
+
+//Static Variables
+std::atomic<uint64_t> CBlockPool::sm_aulAllocations{ 0 };
+std::atomic<uint64_t> CBlockPool::sm_aulHeapAllocations{ 0 };
+
+//Pooled block sizes, anything larger goes straight to the heap
+static const size_t s_blockSizes[] = { 128, 256, 512, 1024, 2048, 4096 };
+static const unsigned int s_blockClasses = sizeof(s_blockSizes) / sizeof(size_t);
+
+//Each block starts with a header saying which free list it goes back to
+union BlockHeader
+{
+	unsigned int m_uiClass;
+	std::max_align_t m_align;
+};
+
+//Recycled blocks, one free list per size, given back to the heap at exit
+struct BlockFreeList
+{
+	~BlockFreeList()
+	{
+		for (unsigned int i = 0; i < s_blockClasses; i++)
+		{
+			for (size_t j = 0; j < m_blocks[i].size(); j++)
+			{
+				::operator delete(m_blocks[i][j]);
+			}
+		}
+	}
+
+	std::mutex m_mutex;
+	std::vector<BlockHeader*> m_blocks[s_blockClasses];
+};
+static BlockFreeList s_freeBlocks;
+
+//	Allocate( _size )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Gets a block of at least _size bytes, reusing a freed block of the
+//		same size class when there is one.
+//
+//	Param:
+//		- size_t	|	Bytes needed.
+//
+//	Return: void*	|	Block of at least _size bytes, aligned for any type.
+//
+void* CBlockPool::Allocate(size_t _size)
+{
+	sm_aulAllocations++;
+
+	unsigned int sizeClass = 0;
+	while (sizeClass < s_blockClasses && s_blockSizes[sizeClass] < _size)
+	{
+		sizeClass++;
+	}
+
+	if (sizeClass < s_blockClasses)
+	{
+		std::lock_guard<std::mutex> _lock(s_freeBlocks.m_mutex);
+		if (!s_freeBlocks.m_blocks[sizeClass].empty())
+		{
+			BlockHeader* header = s_freeBlocks.m_blocks[sizeClass].back();
+			s_freeBlocks.m_blocks[sizeClass].pop_back();
+			return header + 1;
+		}
+	}
+
+	size_t bytes = (sizeClass < s_blockClasses) ? s_blockSizes[sizeClass] : _size;
+	BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + bytes));
+	header->m_uiClass = sizeClass;
+	sm_aulHeapAllocations++;
+	return header + 1;
+}
+
+//	Free( _block )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Returns a block to its free list, or to the heap if it was too large
+//		to pool.
+//
+//	Param:
+//		- void*		|	Block from Allocate.
+//
+//	Return: n/a		|
+//
+void CBlockPool::Free(void* _block)
+{
+	if (_block == nullptr)
+	{
+		return;
+	}
+
+	BlockHeader* header = static_cast<BlockHeader*>(_block) - 1;
+	if (header->m_uiClass < s_blockClasses)
+	{
+		std::lock_guard<std::mutex> _lock(s_freeBlocks.m_mutex);
+		s_freeBlocks.m_blocks[header->m_uiClass].push_back(header);
+		return;
+	}
+	::operator delete(header);
+}
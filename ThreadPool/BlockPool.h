@@ -0,0 +1,64 @@
+#ifndef __BLOCKPOOL_H__
+#define __BLOCKPOOL_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	BlockPool.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CBlockPool
+// Description:
+//		Process wide pool of memory blocks in a few fixed size classes. Freed
+//		blocks go onto a free list for their size and are handed out again,
+//		so code which allocates the same sizes every frame stops touching the
+//		heap once it has warmed up. Used for oversized task callables and
+//		coroutine frames.
+//
+
+//Library Includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class CBlockPool
+{
+	//Static Functions:
+public:
+	static void* Allocate(size_t _size);
+	static void Free(void* _block);
+
+	//Allocation counters, compare before and after a frame
+	static uint64_t GetAllocations() { return sm_aulAllocations; };
+	static uint64_t GetHeapAllocations() { return sm_aulHeapAllocations; };
+
+private:
+	CBlockPool() = delete;
+
+	//Static Data:
+private:
+	static std::atomic<uint64_t> sm_aulAllocations;
+	static std::atomic<uint64_t> sm_aulHeapAllocations;
+};
+
+//Hands out CBlockPool blocks to std::allocate_shared, so a shared object
+//and its reference count are recycled like everything else
+template<typename T>
+class CBlockAllocator
+{
+public:
+	typedef T value_type;
+
+	CBlockAllocator() {};
+	template<typename U>
+	CBlockAllocator(const CBlockAllocator<U>&) {};
+
+	T* allocate(size_t _count) { return static_cast<T*>(CBlockPool::Allocate(_count * sizeof(T))); };
+	void deallocate(T* _p, size_t) { CBlockPool::Free(_p); };
+
+	template<typename U>
+	bool operator==(const CBlockAllocator<U>&) const { return true; };
+	template<typename U>
+	bool operator!=(const CBlockAllocator<U>&) const { return false; };
+};
+
+#endif // !__BLOCKPOOL_H__
@@ -0,0 +1,220 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	Coroutine.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CoTask, ScheduleAwaiter, MainThreadAwaiter, WhenAllAwaiter
+// Description:
+//		C++20 coroutine front end for the ThreadPool. A CoTask starts running
+//		on the thread which calls it and moves between threads with co_await:
+//			co_await ThreadPool::GetInstance().Schedule();	//onto a worker
+//			co_await WhenAll(groups);						//after the groups finish
+//			co_await ResumeOnMainThread();					//onto the GLUT thread
+//		Frames come from the CBlockPool and resuming only moves a handle
+//		through the work queue, so nothing allocates once warmed up.
+//
+
+//Self Include
+#include "Coroutine.h"
+
+//Library Includes
+#include <new>
+
+//Local Includes
+#include "ThreadPool.h"
+#include "SceneManager.h"
+
+//	await_suspend( _handle )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Posts the suspended coroutine to the pool, the worker which takes it
+//		resumes it.
+//
+//	Param:
+//		- std::coroutine_handle<>	|	Suspended coroutine.
+//
+//	Return: n/a		|
+//
+void ScheduleAwaiter::await_suspend(std::coroutine_handle<> _handle)
+{
+	CFunctionTask task([_handle]() { _handle.resume(); });
+	task.SetQoS(m_eQoS);
+	m_pPool->Post(std::move(task));
+}
+
+//	await_suspend( _handle )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Posts the suspended coroutine to the main thread queue, which
+//		SceneManager::Process runs once per frame.
+//
+//	Param:
+//		- std::coroutine_handle<>	|	Suspended coroutine.
+//
+//	Return: n/a		|
+//
+void MainThreadAwaiter::await_suspend(std::coroutine_handle<> _handle)
+{
+	SceneManager::PostToMainThread([_handle]() { _handle.resume(); });
+}
+
+//Constructor
+WhenAllAwaiter::WhenAllAwaiter(const std::shared_ptr<TaskGroup>* _pGroups, size_t _count)
+	: m_count(_count)
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	m_pNodes = static_cast<Node*>(CBlockPool::Allocate(sizeof(Node) * m_count));
+	for (size_t i = 0; i < m_count; i++)
+	{
+		new (&m_pNodes[i]) Node();
+		m_pNodes[i].m_pOwner = this;
+		m_pNodes[i].m_pGroup = _pGroups[i];
+	}
+}
+
+//Destructor
+WhenAllAwaiter::~WhenAllAwaiter()
+{
+	for (size_t i = 0; i < m_count; i++)
+	{
+		m_pNodes[i].~Node();
+	}
+	CBlockPool::Free(m_pNodes);
+}
+
+//	await_ready( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Skips suspending when every group has already finished.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: bool	|	True if there is nothing to wait for.
+//
+bool WhenAllAwaiter::await_ready() const
+{
+	for (size_t i = 0; i < m_count; i++)
+	{
+		if (m_pNodes[i].m_pGroup && !m_pNodes[i].m_pGroup->IsComplete())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//	await_suspend( _handle )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Links a continuation into each group. The last group to finish
+//		resumes the coroutine. If they all finished while linking, the
+//		coroutine carries on without suspending.
+//
+//	Param:
+//		- std::coroutine_handle<>	|	Suspended coroutine.
+//
+//	Return: bool	|	False to resume the coroutine straight away.
+//
+bool WhenAllAwaiter::await_suspend(std::coroutine_handle<> _handle)
+{
+	m_handle = _handle;
+	m_remaining = m_count + 1;
+
+	for (size_t i = 0; i < m_count; i++)
+	{
+		if (!m_pNodes[i].m_pGroup || !m_pNodes[i].m_pGroup->AddContinuation(&m_pNodes[i]))
+		{
+			m_remaining--;
+		}
+	}
+
+	//Drop our own count, if that was the last the groups are all done
+	return m_remaining.fetch_sub(1) != 1;
+}
+
+//	Resume( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Called when this node's group finishes, resumes the coroutine if it
+//		was the last group outstanding.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void WhenAllAwaiter::Node::Resume()
+{
+	if (m_pOwner->m_remaining.fetch_sub(1) == 1)
+	{
+		m_pOwner->m_handle.resume();
+	}
+}
+
+//	ResumeOnMainThread( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		co_await the result to carry on on the GLUT main thread, where it is
+//		safe to call OpenGL.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: MainThreadAwaiter	|	Awaitable.
+//
+MainThreadAwaiter ResumeOnMainThread()
+{
+	return MainThreadAwaiter();
+}
+
+//	WhenAll( _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		co_await the result to carry on once every task of the group has
+//		finished, or been dropped by a cancel.
+//
+//	Param:
+//		- std::shared_ptr<TaskGroup>&	|	Group to wait for.
+//
+//	Return: WhenAllAwaiter	|	Awaitable.
+//
+WhenAllAwaiter WhenAll(const std::shared_ptr<TaskGroup>& _group)
+{
+	return WhenAllAwaiter(&_group, 1);
+}
+
+//	WhenAll( _groups )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		co_await the result to carry on once every group has finished.
+//
+//	Param:
+//		- std::vector<std::shared_ptr<TaskGroup>>&	|	Groups to wait for.
+//
+//	Return: WhenAllAwaiter	|	Awaitable.
+//
+WhenAllAwaiter WhenAll(const std::vector<std::shared_ptr<TaskGroup>>& _groups)
+{
+	return WhenAllAwaiter(_groups.data(), _groups.size());
+}
@@ -0,0 +1,155 @@
+#ifndef __COROUTINE_H__
+#define __COROUTINE_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	Coroutine.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CoTask, ScheduleAwaiter, MainThreadAwaiter, WhenAllAwaiter
+// Description:
+//		C++20 coroutine front end for the ThreadPool. A CoTask starts running
+//		on the thread which calls it and moves between threads with co_await:
+//			co_await ThreadPool::GetInstance().Schedule();	//onto a worker
+//			co_await WhenAll(groups);						//after the groups finish
+//			co_await ResumeOnMainThread();					//onto the GLUT thread
+//		Frames and their done latches come from the CBlockPool and resuming
+//		only moves a handle through the work queue, so nothing allocates
+//		once warmed up.
+//
+
+//Library Includes
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <vector>
+
+//Local Includes
+#include "TaskGroup.h"
+#include "BlockPool.h"
+
+//Forward Declaration
+class ThreadPool;
+
+//Resumes the coroutine on a pool worker
+class ScheduleAwaiter
+{
+public:
+	ScheduleAwaiter(ThreadPool* _pPool, QoSClass _class) : m_pPool(_pPool), m_eQoS(_class) {};
+
+	bool await_ready() const noexcept { return false; };
+	void await_suspend(std::coroutine_handle<> _handle);
+	void await_resume() const noexcept {};
+
+private:
+	ThreadPool* m_pPool;
+	QoSClass m_eQoS;
+};
+
+//Resumes the coroutine on the GLUT main thread, from SceneManager::Process
+class MainThreadAwaiter
+{
+public:
+	bool await_ready() const noexcept { return false; };
+	void await_suspend(std::coroutine_handle<> _handle);
+	void await_resume() const noexcept {};
+};
+
+//Resumes the coroutine once every group has finished, on the thread which
+//finished the last task. Resumes straight away if they already have.
+class WhenAllAwaiter
+{
+public:
+	WhenAllAwaiter(const std::shared_ptr<TaskGroup>* _pGroups, size_t _count);
+	~WhenAllAwaiter();
+
+	bool await_ready() const;
+	bool await_suspend(std::coroutine_handle<> _handle);
+	void await_resume() const noexcept {};
+
+private:
+	//The WhenAllAwaiter is non-copyable.
+	WhenAllAwaiter(const WhenAllAwaiter& _kr) = delete;
+	WhenAllAwaiter& operator= (const WhenAllAwaiter& _kr) = delete;
+
+	struct Node : public TaskGroup::Continuation
+	{
+		virtual void Resume();
+
+		WhenAllAwaiter* m_pOwner = nullptr;
+		std::shared_ptr<TaskGroup> m_pGroup;
+	};
+
+	//Member Data:
+private:
+	//One node per group, from the CBlockPool
+	Node* m_pNodes = nullptr;
+	size_t m_count = 0;
+
+	//Groups still running, plus one held by await_suspend while it links
+	std::atomic<size_t> m_remaining{ 0 };
+	std::coroutine_handle<> m_handle;
+};
+
+//Fire and forget coroutine, its TaskHandle completes when it returns
+class CoTask
+{
+public:
+	class promise_type
+	{
+	public:
+		//The done latch outlives the frame, so it gets its own pooled block
+		promise_type() : m_pDone(std::allocate_shared<TaskGroup>(CBlockAllocator<TaskGroup>())) { m_pDone->Add(); };
+
+		CoTask get_return_object() { return CoTask(m_pDone); };
+		std::suspend_never initial_suspend() const noexcept { return {}; };
+		auto final_suspend() const noexcept { return FinalAwaiter(); };
+		void return_void() const noexcept {};
+		void unhandled_exception() const noexcept { std::terminate(); };
+
+		//Frames are recycled through the block pool
+		static void* operator new(size_t _size) { return CBlockPool::Allocate(_size); };
+		static void operator delete(void* _pFrame) { CBlockPool::Free(_pFrame); };
+
+	private:
+		friend class CoTask;
+		std::shared_ptr<TaskGroup> m_pDone;
+	};
+
+	CoTask() {};
+
+	TaskHandle GetHandle() const { return TaskHandle(m_pDone); };
+	bool IsComplete() const { return !m_pDone || m_pDone->IsComplete(); };
+	void Wait() { if (m_pDone) m_pDone->Wait(); };
+
+	//Another coroutine can co_await this one
+	WhenAllAwaiter operator co_await() const { return WhenAllAwaiter(&m_pDone, m_pDone ? 1 : 0); };
+
+private:
+	CoTask(std::shared_ptr<TaskGroup> _done) : m_pDone(_done) {};
+
+	//Frees the frame then completes the group, so waiters never see a live frame
+	struct FinalAwaiter
+	{
+		bool await_ready() const noexcept { return false; };
+		void await_suspend(std::coroutine_handle<promise_type> _handle) const noexcept
+		{
+			std::shared_ptr<TaskGroup> done = std::move(_handle.promise().m_pDone);
+			_handle.destroy();
+			done->Done();
+		};
+		void await_resume() const noexcept {};
+	};
+
+	//Member Data:
+private:
+	std::shared_ptr<TaskGroup> m_pDone;
+};
+
+//Awaitables
+MainThreadAwaiter ResumeOnMainThread();
+WhenAllAwaiter WhenAll(const std::shared_ptr<TaskGroup>& _group);
+WhenAllAwaiter WhenAll(const std::vector<std::shared_ptr<TaskGroup>>& _groups);
+
+#endif // !__COROUTINE_H__
@@ -0,0 +1,410 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	CostMap.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CostMap
+// Description:
+//		Coarse grid of what each part of a view cost to compute, recorded
+//		by the tiles of one frame and moved onto the next view after a pan
+//		or zoom. Consecutive views overlap, so the last frame predicts the
+//		next: tiles can be ordered longest first and cut to equal cost.
+//
+
+//Self Include
+#include "CostMap.h"
+
+//Library Includes
+#include <algorithm>
+#include <cmath>
+
+//Local Includes
+#include "RenderJob.h"
+#include "Task.h"
+
+//Constructor
+CostMap::CostMap(int _cellSize)
+	: m_iCellSize(std::max(1, _cellSize))
+{
+
+}
+
+//Destructor
+CostMap::~CostMap()
+{
+
+}
+
+//	Reproject( _job )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Moves what was recorded onto the view of _job and clears the record
+//		for its tiles. Each new cell takes the iterations per pixel of the
+//		old cells under it, which holds across zooms as the cost of a pixel
+//		only depends on where it is on the complex plane. Cells the last
+//		view didn't record keep what it predicted for them. Only call
+//		while no tile of the map's view is running.
+//
+//	Param:
+//		- RenderJob&	|	Job whose view the next tiles compute.
+//
+//	Return: n/a		|
+//
+void CostMap::Reproject(const RenderJob& _job)
+{
+	//Iterations per pixel of the old view
+	std::vector<float> old(static_cast<size_t>(m_iColumns) * m_iRows, -1.0f);
+	for (size_t i = 0; i < old.size(); i++)
+	{
+		uint64_t pixels = m_pRecorded[i].m_ulPixels.load(std::memory_order_relaxed);
+		if (pixels > 0)
+		{
+			old[i] = static_cast<float>(m_pRecorded[i].m_ulIterations.load(std::memory_order_relaxed)) / pixels;
+		}
+		else if (i < m_predicted.size())
+		{
+			old[i] = m_predicted[i];
+		}
+	}
+	const float oldLeft = m_fLeft;
+	const float oldTop = m_fTop;
+	const float oldPixelWidth = m_fPixelWidth;
+	const float oldPixelHeight = m_fPixelHeight;
+	const int oldWidth = m_iWidth;
+	const int oldHeight = m_iHeight;
+	const int oldRows = m_iRows;
+
+	m_fLeft = _job.GetLeft();
+	m_fTop = _job.GetTop();
+	m_fPixelWidth = _job.GetPixelWidth();
+	m_fPixelHeight = _job.GetPixelHeight();
+	m_iWidth = _job.GetWidth();
+	m_iHeight = _job.GetHeight();
+	m_iColumns = (m_iWidth + m_iCellSize - 1) / m_iCellSize;
+	m_iRows = (m_iHeight + m_iCellSize - 1) / m_iCellSize;
+	m_pRecorded.reset(new Cell[static_cast<size_t>(m_iColumns) * m_iRows]);
+	m_predicted.assign(static_cast<size_t>(m_iColumns) * m_iRows, -1.0f);
+
+	//Sample the old view at four points of each new cell
+	const float offsets[] = { 0.25f, 0.75f };
+	double knownSum = 0.0;
+	long long knownPixels = 0;
+	for (int cx = 0; cx < m_iColumns; cx++)
+	{
+		for (int cy = 0; cy < m_iRows; cy++)
+		{
+			Range2D cell = Range2D(cx * m_iCellSize, (cx + 1) * m_iCellSize, cy * m_iCellSize, (cy + 1) * m_iCellSize).Intersect(_job.GetBounds());
+
+			float sum = 0.0f;
+			int samples = 0;
+			for (float fx : offsets)
+			{
+				for (float fy : offsets)
+				{
+					float x = cell.m_iBeginX + cell.Width() * fx;
+					float y = cell.m_iBeginY + cell.Height() * fy;
+
+					//Same point of the complex plane in the old view's pixels
+					float oldX = (m_fLeft + x * m_fPixelWidth - oldLeft) / oldPixelWidth;
+					float oldY = (oldTop - (m_fTop - y * m_fPixelHeight)) / oldPixelHeight;
+					if (oldX < 0.0f || oldY < 0.0f || oldX >= oldWidth || oldY >= oldHeight)
+					{
+						continue;
+					}
+
+					float density = old[static_cast<size_t>(oldX / m_iCellSize) * oldRows + static_cast<size_t>(oldY / m_iCellSize)];
+					if (density >= 0.0f)
+					{
+						sum += density;
+						samples++;
+					}
+				}
+			}
+
+			if (samples > 0)
+			{
+				float density = sum / samples;
+				m_predicted[static_cast<size_t>(cx) * m_iRows + cy] = density;
+				knownSum += static_cast<double>(density) * cell.Area();
+				knownPixels += cell.Area();
+			}
+		}
+	}
+
+	//Parts of the view nobody has seen cost the average
+	m_bHasEstimate = knownPixels > 0;
+	m_fMeanPredicted = m_bHasEstimate ? static_cast<float>(knownSum / knownPixels) : 0.0f;
+}
+
+//	Record( _tile, _iterations, _nanoseconds )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds what a tile of the current view cost, spread evenly over its
+//		pixels. Safe to call from every worker at once.
+//
+//	Param:
+//		- Range2D&	|	Pixels the tile computed, clipped to the image.
+//		- uint64_t	|	Iterations the tile ran.
+//		- uint64_t	|	Wall time the tile took.
+//
+//	Return: n/a		|
+//
+void CostMap::Record(const Range2D& _tile, uint64_t _iterations, uint64_t _nanoseconds)
+{
+	Range2D tile = _tile.Intersect(Range2D(0, m_iWidth, 0, m_iHeight));
+	long long pixels = tile.Area();
+	if (pixels == 0 || !m_pRecorded)
+	{
+		return;
+	}
+
+	for (int cx = tile.m_iBeginX / m_iCellSize; cx <= (tile.m_iEndX - 1) / m_iCellSize; cx++)
+	{
+		for (int cy = tile.m_iBeginY / m_iCellSize; cy <= (tile.m_iEndY - 1) / m_iCellSize; cy++)
+		{
+			long long overlap = tile.Intersect(Range2D(cx * m_iCellSize, (cx + 1) * m_iCellSize, cy * m_iCellSize, (cy + 1) * m_iCellSize)).Area();
+
+			Cell& cell = m_pRecorded[static_cast<size_t>(cx) * m_iRows + cy];
+			cell.m_ulIterations.fetch_add(_iterations * overlap / pixels, std::memory_order_relaxed);
+			cell.m_ulNanoseconds.fetch_add(_nanoseconds * overlap / pixels, std::memory_order_relaxed);
+			cell.m_ulPixels.fetch_add(overlap, std::memory_order_relaxed);
+		}
+	}
+}
+
+//	Estimate( _range )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Predicts the iterations the pixels of _range will take in the
+//		current view. Without an estimate every pixel costs one.
+//
+//	Param:
+//		- Range2D&	|	Pixels to estimate.
+//
+//	Return: double	|	Predicted iterations.
+//
+double CostMap::Estimate(const Range2D& _range) const
+{
+	Range2D range = _range.Intersect(Range2D(0, m_iWidth, 0, m_iHeight));
+	if (!m_bHasEstimate || range.Empty())
+	{
+		return static_cast<double>(range.Area());
+	}
+
+	double cost = 0.0;
+	for (int cx = range.m_iBeginX / m_iCellSize; cx <= (range.m_iEndX - 1) / m_iCellSize; cx++)
+	{
+		for (int cy = range.m_iBeginY / m_iCellSize; cy <= (range.m_iEndY - 1) / m_iCellSize; cy++)
+		{
+			long long overlap = range.Intersect(Range2D(cx * m_iCellSize, (cx + 1) * m_iCellSize, cy * m_iCellSize, (cy + 1) * m_iCellSize)).Area();
+			float density = m_predicted[static_cast<size_t>(cx) * m_iRows + cy];
+			cost += overlap * ((density >= 0.0f) ? density : m_fMeanPredicted);
+		}
+	}
+	return cost;
+}
+
+//	LongestFirst( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Priority function putting the tiles predicted to take longest
+//		first. Starting the long tiles early keeps one of them from being
+//		the last thing running while the other workers sit idle. The map
+//		must outlive the function and not be reprojected while it is used.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: PriorityFunction	|	Negative predicted iterations of a tile.
+//
+PriorityFunction CostMap::LongestFirst() const
+{
+	return [this](const CTask& _task)
+	{
+		return -static_cast<float>(Estimate(_task.GetRange()));
+	};
+}
+
+//	CreateBalancedTiles( _job, _tileCount, _tasks )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Cuts the view into about _tileCount tiles of equal predicted cost.
+//		The view is halved along its longer side at the cell boundary
+//		closest to half the cost, then each half is cut the same way, so
+//		tiles are small where the set is expensive and large where it
+//		isn't. Cuts fall on cell boundaries, so no tile is below a cell.
+//
+//	Param:
+//		- RenderJob&			|	Job to make the tiles for, the map's current view.
+//		- int					|	Number of tiles to aim for.
+//		- std::vector<CTask>&	|	Vector to fill with the tasks.
+//
+//	Return: n/a		|
+//
+void CostMap::CreateBalancedTiles(RenderJob& _job, int _tileCount, std::vector<CTask>& _tasks) const
+{
+	if (m_iColumns == 0 || m_iRows == 0)
+	{
+		return;
+	}
+
+	//Summed area table of the cell costs, so any block of cells is four lookups
+	std::vector<double> sums(static_cast<size_t>(m_iColumns + 1) * (m_iRows + 1), 0.0);
+	for (int cx = 0; cx < m_iColumns; cx++)
+	{
+		for (int cy = 0; cy < m_iRows; cy++)
+		{
+			sums[static_cast<size_t>(cx + 1) * (m_iRows + 1) + (cy + 1)] = CellCost(cx, cy)
+				+ sums[static_cast<size_t>(cx) * (m_iRows + 1) + (cy + 1)]
+				+ sums[static_cast<size_t>(cx + 1) * (m_iRows + 1) + cy]
+				- sums[static_cast<size_t>(cx) * (m_iRows + 1) + cy];
+		}
+	}
+
+	_tasks.reserve(_tasks.size() + std::max(1, _tileCount));
+	Split(_job, sums, Range2D(0, m_iColumns, 0, m_iRows), std::max(1, _tileCount), _tasks);
+}
+
+//	GetRecordedIterations( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Iterations the current view's tiles have recorded so far.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: uint64_t	|	Sum over every cell.
+//
+uint64_t CostMap::GetRecordedIterations() const
+{
+	uint64_t total = 0;
+	for (size_t i = 0; i < static_cast<size_t>(m_iColumns) * m_iRows; i++)
+	{
+		total += m_pRecorded[i].m_ulIterations.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+//	GetRecordedNanoseconds( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Tile wall time the current view's tiles have recorded so far.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: uint64_t	|	Sum over every cell.
+//
+uint64_t CostMap::GetRecordedNanoseconds() const
+{
+	uint64_t total = 0;
+	for (size_t i = 0; i < static_cast<size_t>(m_iColumns) * m_iRows; i++)
+	{
+		total += m_pRecorded[i].m_ulNanoseconds.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+//	CellCost( _column, _row )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Predicted iterations of every pixel of one cell of the current view.
+//		
+//	Param:
+//		- int		|	Column of the cell.
+//		- int		|	Row of the cell.
+//
+//	Return: double	|	Predicted iterations.
+//
+double CostMap::CellCost(int _column, int _row) const
+{
+	return Estimate(Range2D(_column * m_iCellSize, (_column + 1) * m_iCellSize, _row * m_iCellSize, (_row + 1) * m_iCellSize));
+}
+
+//	SumCells( _sums, _cells )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Predicted iterations of a block of cells from the summed area table.
+//		
+//	Param:
+//		- std::vector<double>&	|	Summed area table of the cell costs.
+//		- Range2D&				|	Block of cells, in cells.
+//
+//	Return: double	|	Predicted iterations.
+//
+double CostMap::SumCells(const std::vector<double>& _sums, const Range2D& _cells) const
+{
+	const size_t stride = static_cast<size_t>(m_iRows) + 1;
+	return _sums[_cells.m_iEndX * stride + _cells.m_iEndY] - _sums[_cells.m_iBeginX * stride + _cells.m_iEndY]
+		- _sums[_cells.m_iEndX * stride + _cells.m_iBeginY] + _sums[_cells.m_iBeginX * stride + _cells.m_iBeginY];
+}
+
+//	Split( _job, _sums, _cells, _tileCount, _tasks )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Cuts a block of cells into _tileCount tiles of about equal cost, or
+//		adds it as one tile once it is down to one tile or one cell.
+//		
+//	Param:
+//		- RenderJob&			|	Job to make the tiles for.
+//		- std::vector<double>&	|	Summed area table of the cell costs.
+//		- Range2D&				|	Block of cells to cut, in cells.
+//		- int					|	Number of tiles to cut it into.
+//		- std::vector<CTask>&	|	Vector to add the tiles to.
+//
+//	Return: n/a		|
+//
+void CostMap::Split(RenderJob& _job, const std::vector<double>& _sums, const Range2D& _cells, int _tileCount, std::vector<CTask>& _tasks) const
+{
+	bool acrossX = _cells.Width() >= _cells.Height();
+	if (_tileCount <= 1 || (acrossX ? _cells.Width() : _cells.Height()) <= 1)
+	{
+		Range2D pixels = Range2D(_cells.m_iBeginX * m_iCellSize, _cells.m_iEndX * m_iCellSize, _cells.m_iBeginY * m_iCellSize, _cells.m_iEndY * m_iCellSize).Intersect(_job.GetBounds());
+		_tasks.push_back(CTask(&_job, pixels.m_iBeginX, pixels.m_iBeginY, pixels.Width(), pixels.Height()));
+		return;
+	}
+
+	//The first part gets its share of the tiles and of the cost
+	int firstCount = _tileCount / 2;
+	double target = SumCells(_sums, _cells) * firstCount / _tileCount;
+
+	int begin = acrossX ? _cells.m_iBeginX : _cells.m_iBeginY;
+	int end = acrossX ? _cells.m_iEndX : _cells.m_iEndY;
+	Range2D first = _cells;
+	Range2D second = _cells;
+	double bestError = -1.0;
+	for (int cut = begin + 1; cut < end; cut++)
+	{
+		Range2D candidate = acrossX ? Range2D(_cells.m_iBeginX, cut, _cells.m_iBeginY, _cells.m_iEndY) : Range2D(_cells.m_iBeginX, _cells.m_iEndX, _cells.m_iBeginY, cut);
+		double error = std::abs(SumCells(_sums, candidate) - target);
+		if (bestError < 0.0 || error < bestError)
+		{
+			bestError = error;
+			first = candidate;
+			second = acrossX ? Range2D(cut, _cells.m_iEndX, _cells.m_iBeginY, _cells.m_iEndY) : Range2D(_cells.m_iBeginX, _cells.m_iEndX, cut, _cells.m_iEndY);
+		}
+	}
+
+	Split(_job, _sums, first, firstCount, _tasks);
+	Split(_job, _sums, second, _tileCount - firstCount, _tasks);
+}
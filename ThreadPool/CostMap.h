@@ -0,0 +1,91 @@
+#ifndef __COSTMAP_H__
+#define __COSTMAP_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	CostMap.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CostMap
+// Description:
+//		Coarse grid of what each part of a view cost to compute, recorded
+//		by the tiles of one frame and moved onto the next view after a pan
+//		or zoom. Consecutive views overlap, so the last frame predicts the
+//		next: tiles can be ordered longest first and cut to equal cost.
+//
+
+//Library Includes
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+//Local Includes
+#include "Range2D.h"
+#include "TilePriority.h"
+
+//Forward Declaration
+class RenderJob;
+class CTask;
+
+class CostMap
+{
+	//Member Functions:
+public:
+	CostMap(int _cellSize = 16);
+	~CostMap();
+
+	void Reproject(const RenderJob& _job);
+	void Record(const Range2D& _tile, uint64_t _iterations, uint64_t _nanoseconds);
+
+	bool HasEstimate() const { return m_bHasEstimate; };
+	double Estimate(const Range2D& _range) const;
+	PriorityFunction LongestFirst() const;
+	void CreateBalancedTiles(RenderJob& _job, int _tileCount, std::vector<CTask>& _tasks) const;
+
+	uint64_t GetRecordedIterations() const;
+	uint64_t GetRecordedNanoseconds() const;
+
+protected:
+	double CellCost(int _column, int _row) const;
+	double SumCells(const std::vector<double>& _sums, const Range2D& _cells) const;
+	void Split(RenderJob& _job, const std::vector<double>& _sums, const Range2D& _cells, int _tileCount, std::vector<CTask>& _tasks) const;
+
+private:
+	//The CostMap is non-copyable.
+	CostMap(const CostMap& _kr) = delete;
+	CostMap& operator= (const CostMap& _kr) = delete;
+
+	//Member Data:
+private:
+	struct Cell
+	{
+		std::atomic<uint64_t> m_ulIterations{ 0 };
+		std::atomic<uint64_t> m_ulNanoseconds{ 0 };
+		std::atomic<uint64_t> m_ulPixels{ 0 };
+	};
+
+	//Width and height of a cell in pixels
+	int m_iCellSize;
+
+	//View the cells cover, set by the last Reproject
+	float m_fLeft = 0.0f;
+	float m_fTop = 0.0f;
+	float m_fPixelWidth = 1.0f;
+	float m_fPixelHeight = 1.0f;
+	int m_iWidth = 0;
+	int m_iHeight = 0;
+	int m_iColumns = 0;
+	int m_iRows = 0;
+
+	//What this view's tiles have recorded so far, cell [x * rows + y]
+	std::unique_ptr<Cell[]> m_pRecorded;
+
+	//Iterations per pixel carried over from the last view, negative where
+	//the last view didn't reach
+	std::vector<float> m_predicted;
+	float m_fMeanPredicted = 0.0f;
+	bool m_bHasEstimate = false;
+};
+
+#endif // !__COSTMAP_H__
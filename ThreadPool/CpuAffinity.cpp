@@ -0,0 +1,389 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	CpuAffinity.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CpuAffinity
+// Description:
+//		Reads the processor topology (cores, SMT siblings and NUMA nodes) and
+//		pins threads to sets of logical processors. Uses sysfs and
+//		pthread_setaffinity_np on Linux, and the Win32 processor information
+//		and affinity mask functions on Windows.
+//
+
+//Self Include
+#include "CpuAffinity.h"
+
+//Library Includes
+#include <map>
+#include <thread>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifndef _WIN32
+//Reads the first line of a sysfs file, empty if it doesn't exist
+static std::string ReadLine(const std::string& _path)
+{
+	std::ifstream file(_path);
+	std::string line;
+	if (file.is_open())
+	{
+		std::getline(file, line);
+	}
+	return line;
+}
+#endif
+
+//	QueryTopology( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Lists every online logical processor with the physical core and NUMA
+//		node it belongs to. Falls back to one core per processor on node 0
+//		when the topology can't be read.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: std::vector<LogicalCpu>	|	Processors ordered by id.
+//
+std::vector<LogicalCpu> CpuAffinity::QueryTopology()
+{
+	std::vector<LogicalCpu> cpus;
+
+#ifdef _WIN32
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+	std::vector<char> buffer(length);
+	PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data());
+
+	std::map<unsigned int, LogicalCpu> found;
+	if (length > 0 && GetLogicalProcessorInformationEx(RelationAll, info, &length))
+	{
+		unsigned int core = 0;
+		for (DWORD offset = 0; offset < length; offset += info->Size)
+		{
+			info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+
+			//Only processor group 0 is used, so ids fit in one affinity mask
+			if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+			{
+				bool first = true;
+				for (unsigned int bit = 0; bit < sizeof(KAFFINITY) * 8; bit++)
+				{
+					if (info->Processor.GroupMask[0].Mask & (static_cast<KAFFINITY>(1) << bit))
+					{
+						found[bit].m_uiId = bit;
+						found[bit].m_uiCore = core;
+						found[bit].m_uiNode = 0;
+						found[bit].m_bSibling = !first;
+						first = false;
+					}
+				}
+				core++;
+			}
+		}
+
+		for (DWORD offset = 0; offset < length; offset += info->Size)
+		{
+			info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+			if (info->Relationship == RelationNumaNode && info->NumaNode.GroupMask.Group == 0)
+			{
+				for (unsigned int bit = 0; bit < sizeof(KAFFINITY) * 8; bit++)
+				{
+					if (found.count(bit) && (info->NumaNode.GroupMask.Mask & (static_cast<KAFFINITY>(1) << bit)))
+					{
+						found[bit].m_uiNode = info->NumaNode.NodeNumber;
+					}
+				}
+			}
+		}
+	}
+
+	for (std::map<unsigned int, LogicalCpu>::iterator it = found.begin(); it != found.end(); ++it)
+	{
+		cpus.push_back(it->second);
+	}
+#else
+	std::vector<unsigned int> online = ParseCpuList(ReadLine("/sys/devices/system/cpu/online"));
+
+	//Node of each processor, nodes can be numbered with gaps
+	std::map<unsigned int, unsigned int> nodeOf;
+	for (unsigned int node = 0; node < 256; node++)
+	{
+		std::vector<unsigned int> list = ParseCpuList(ReadLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+		for (unsigned int i = 0; i < list.size(); i++)
+		{
+			nodeOf[list[i]] = node;
+		}
+	}
+
+	//Number each (package, core) pair
+	std::map<std::pair<int, int>, unsigned int> coreIds;
+	for (unsigned int i = 0; i < online.size(); i++)
+	{
+		std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(online[i]) + "/topology/";
+		std::string package = ReadLine(topology + "physical_package_id");
+		std::string core = ReadLine(topology + "core_id");
+		std::vector<unsigned int> siblings = ParseCpuList(ReadLine(topology + "thread_siblings_list"));
+
+		std::pair<int, int> key(package.empty() ? 0 : std::stoi(package), core.empty() ? static_cast<int>(online[i]) : std::stoi(core));
+		if (coreIds.count(key) == 0)
+		{
+			unsigned int next = static_cast<unsigned int>(coreIds.size());
+			coreIds[key] = next;
+		}
+
+		LogicalCpu cpu;
+		cpu.m_uiId = online[i];
+		cpu.m_uiCore = coreIds[key];
+		cpu.m_uiNode = nodeOf.count(online[i]) ? nodeOf[online[i]] : 0;
+		cpu.m_bSibling = !siblings.empty() && siblings[0] != online[i];
+		cpus.push_back(cpu);
+	}
+#endif
+
+	if (cpus.empty())
+	{
+		unsigned int count = std::thread::hardware_concurrency();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			LogicalCpu cpu = { i, i, 0, false };
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+//	PlanWorkers( _workers, _mode, _skipSMT )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Decides where each worker may run. Core mode gives each worker its own
+//		processor, dealt round robin across the nodes so both sockets fill up
+//		evenly. Node mode lets each worker float over every processor of one
+//		node. Workers wrap around if there are more workers than places.
+//
+//	Param:
+//		- unsigned int	|	Number of workers.
+//		- AffinityMode	|	How to pin the workers.
+//		- bool			|	Leave the second hyperthread of each core unused.
+//
+//	Return: std::vector<WorkerPlacement>	|	One placement per worker.
+//
+std::vector<WorkerPlacement> CpuAffinity::PlanWorkers(unsigned int _workers, AffinityMode _mode, bool _skipSMT)
+{
+	std::vector<WorkerPlacement> placements(_workers);
+	for (unsigned int i = 0; i < _workers; i++)
+	{
+		placements[i].m_uiNode = 0;
+	}
+
+	if (_mode == AFFINITY_NONE || _workers == 0)
+	{
+		return placements;
+	}
+
+	//Usable processors grouped by node
+	std::map<unsigned int, std::vector<LogicalCpu>> nodes;
+	std::vector<LogicalCpu> cpus = QueryTopology();
+	for (unsigned int i = 0; i < cpus.size(); i++)
+	{
+		if (!_skipSMT || !cpus[i].m_bSibling)
+		{
+			nodes[cpus[i].m_uiNode].push_back(cpus[i]);
+		}
+	}
+
+	if (nodes.empty())
+	{
+		return placements;
+	}
+
+	if (_mode == AFFINITY_NODE)
+	{
+		std::vector<unsigned int> nodeIds;
+		for (std::map<unsigned int, std::vector<LogicalCpu>>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+		{
+			nodeIds.push_back(it->first);
+		}
+
+		for (unsigned int i = 0; i < _workers; i++)
+		{
+			unsigned int node = nodeIds[i % nodeIds.size()];
+			placements[i].m_uiNode = node;
+			for (unsigned int c = 0; c < nodes[node].size(); c++)
+			{
+				placements[i].m_cpus.push_back(nodes[node][c].m_uiId);
+			}
+		}
+		return placements;
+	}
+
+	//Core mode: take one processor from each node in turn
+	std::vector<LogicalCpu> order;
+	for (unsigned int depth = 0; order.size() < cpus.size(); depth++)
+	{
+		size_t before = order.size();
+		for (std::map<unsigned int, std::vector<LogicalCpu>>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+		{
+			if (depth < it->second.size())
+			{
+				order.push_back(it->second[depth]);
+			}
+		}
+		if (order.size() == before)
+		{
+			break;
+		}
+	}
+
+	for (unsigned int i = 0; i < _workers; i++)
+	{
+		const LogicalCpu& cpu = order[i % order.size()];
+		placements[i].m_uiNode = cpu.m_uiNode;
+		placements[i].m_cpus.push_back(cpu.m_uiId);
+	}
+	return placements;
+}
+
+//	PinCurrentThread( _cpus )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Restricts the calling thread to the listed logical processors.
+//		Does nothing if the list is empty.
+//
+//	Param:
+//		- std::vector<unsigned int>&	|	Processors the thread may run on.
+//
+//	Return: bool	|	True if the affinity was set.
+//
+bool CpuAffinity::PinCurrentThread(const std::vector<unsigned int>& _cpus)
+{
+	if (_cpus.empty())
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	DWORD_PTR mask = 0;
+	for (unsigned int i = 0; i < _cpus.size(); i++)
+	{
+		if (_cpus[i] < sizeof(DWORD_PTR) * 8)
+		{
+			mask |= static_cast<DWORD_PTR>(1) << _cpus[i];
+		}
+	}
+	return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned int i = 0; i < _cpus.size(); i++)
+	{
+		if (_cpus[i] < CPU_SETSIZE)
+		{
+			CPU_SET(_cpus[i], &set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+//	ParseMode( _name )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Converts the Affinity setting to an AffinityMode.
+//
+//	Param:
+//		- std::string	|	"None", "Core" or "Node".
+//
+//	Return: AffinityMode	|	Matching mode, AFFINITY_NONE if unknown.
+//
+AffinityMode CpuAffinity::ParseMode(const std::string& _name)
+{
+	if (_name == "Core")
+	{
+		return AFFINITY_CORE;
+	}
+	if (_name == "Node")
+	{
+		return AFFINITY_NODE;
+	}
+	return AFFINITY_NONE;
+}
+
+//	ModeToString( _mode )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Converts an AffinityMode to its setting name.
+//
+//	Param:
+//		- AffinityMode	|	Mode to convert.
+//
+//	Return: std::string	|	Name of the mode.
+//
+std::string CpuAffinity::ModeToString(AffinityMode _mode)
+{
+	switch (_mode)
+	{
+	case AFFINITY_CORE:
+		return "Core";
+
+	case AFFINITY_NODE:
+		return "Node";
+
+	case AFFINITY_NONE:
+	default:
+		return "None";
+	}
+}
+
+//	ParseCpuList( _list )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Expands a sysfs processor list such as "0-3,8,10-11".
+//
+//	Param:
+//		- std::string	|	List to expand.
+//
+//	Return: std::vector<unsigned int>	|	Every processor in the list.
+//
+std::vector<unsigned int> CpuAffinity::ParseCpuList(const std::string& _list)
+{
+	std::vector<unsigned int> cpus;
+	std::stringstream stream(_list);
+	std::string range;
+	while (std::getline(stream, range, ','))
+	{
+		if (range.empty() || range[0] < '0' || range[0] > '9')
+		{
+			continue;
+		}
+
+		size_t dash = range.find('-');
+		unsigned int first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+		unsigned int last = (dash == std::string::npos) ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+		for (unsigned int cpu = first; cpu <= last; cpu++)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
@@ -0,0 +1,64 @@
+#ifndef __CPUAFFINITY_H__
+#define __CPUAFFINITY_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	CpuAffinity.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CpuAffinity
+// Description:
+//		Reads the processor topology (cores, SMT siblings and NUMA nodes) and
+//		pins threads to sets of logical processors. Uses sysfs and
+//		pthread_setaffinity_np on Linux, and the Win32 processor information
+//		and affinity mask functions on Windows.
+//
+
+//Library Includes
+#include <string>
+#include <vector>
+
+//Enums
+enum AffinityMode
+{
+	AFFINITY_NONE, AFFINITY_CORE, AFFINITY_NODE
+};
+
+//One logical processor
+struct LogicalCpu
+{
+	unsigned int m_uiId;
+	unsigned int m_uiCore;
+	unsigned int m_uiNode;
+
+	//True for every hyperthread of a core except the first
+	bool m_bSibling;
+};
+
+//Where one worker is allowed to run, an empty set means anywhere
+struct WorkerPlacement
+{
+	std::vector<unsigned int> m_cpus;
+	unsigned int m_uiNode;
+};
+
+class CpuAffinity
+{
+	//Static Functions:
+public:
+	static std::vector<LogicalCpu> QueryTopology();
+	static std::vector<WorkerPlacement> PlanWorkers(unsigned int _workers, AffinityMode _mode, bool _skipSMT);
+	static bool PinCurrentThread(const std::vector<unsigned int>& _cpus);
+
+	static AffinityMode ParseMode(const std::string& _name);
+	static std::string ModeToString(AffinityMode _mode);
+
+protected:
+	static std::vector<unsigned int> ParseCpuList(const std::string& _list);
+
+private:
+	CpuAffinity();
+	~CpuAffinity();
+};
+
+#endif // !__CPUAFFINITY_H__
@@ -0,0 +1,107 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	DispenserExecutor.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	DispenserExecutor
+// Description:
+//		Frame backend which queues one claim loop per worker instead of one
+//		task per tile. Each loop takes the next tile from a shared atomic
+//		index until none are left, so tiles never go through a queue.
+//		Asynchronous, tiles are claimed in priority order and the frame can
+//		be cancelled.
+//
+
+//Self Include
+#include "DispenserExecutor.h"
+
+//Library Includes
+#include <atomic>
+#include <algorithm>
+
+//Local Includes
+#include "ThreadPool.h"
+#include "Task.h"
+
+//Tiles of one frame and the index of the next one to claim, shared by
+//the frame's claim loops so it lives until the last of them is done
+struct DispenserExecutor::TileDispenser
+{
+	std::vector<CTask> m_tiles;
+	std::atomic<size_t> m_next{ 0 };
+};
+
+//Runs tiles until the dispenser is empty. The loops aren't in the frame's
+//group, so they are never dropped and their run time doesn't count towards
+//its deadline. Tiles of a cancelled or late frame are discarded by RunTile.
+class DispenserExecutor::CClaimLoop
+{
+public:
+	CClaimLoop(std::shared_ptr<TileDispenser> _dispenser, TaskGroup* _pGroup)
+		: m_pDispenser(_dispenser), m_pGroup(_pGroup) {};
+
+	void operator()() const
+	{
+		//Relaxed is enough, the index only hands out slots
+		size_t tile = m_pDispenser->m_next.fetch_add(1, std::memory_order_relaxed);
+		while (tile < m_pDispenser->m_tiles.size())
+		{
+			RunTile(m_pDispenser->m_tiles[tile], *m_pGroup);
+			tile = m_pDispenser->m_next.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+private:
+	std::shared_ptr<TileDispenser> m_pDispenser;
+	TaskGroup* m_pGroup;
+};
+
+//	Dispatch( _pJob, _tiles, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sorts a copy of the tiles by priority and queues a claim loop for
+//		each worker. Only the tiles are counted in the group, so it
+//		completes once every tile is colourised or discarded. The tiles
+//		hold the group and the loops hold the tiles, so nothing is freed
+//		while a loop runs.
+//
+//	Param:
+//		- RenderJob*					|	Image the tiles belong to.
+//		- std::vector<CTask>&			|	Tiles of the frame, with their priorities set.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tiles in.
+//
+//	Return: TaskHandle	|	Handle which completes when every tile is colourised.
+//
+TaskHandle DispenserExecutor::Dispatch(RenderJob*, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group)
+{
+	std::shared_ptr<TileDispenser> dispenser = std::make_shared<TileDispenser>();
+	dispenser->m_tiles = _tiles;
+	for (size_t i = 0; i < dispenser->m_tiles.size(); i++)
+	{
+		dispenser->m_tiles[i].SetGroup(_group);
+	}
+
+	//Lowest priority value first, the same order the priority queue uses
+	std::stable_sort(dispenser->m_tiles.begin(), dispenser->m_tiles.end(), [](const CTask& _a, const CTask& _b)
+	{
+		return _a.GetPriority() < _b.GetPriority();
+	});
+
+	_group->Add(static_cast<int>(dispenser->m_tiles.size()));
+
+	//No more loops than tiles, a loop with nothing to claim is a wasted wake
+	size_t loops = std::min<size_t>(std::max(1u, m_pool.GetWorkerCount()), dispenser->m_tiles.size());
+	std::vector<CFunctionTask> claims;
+	claims.reserve(loops);
+	for (size_t i = 0; i < loops; i++)
+	{
+		claims.push_back(CFunctionTask(CClaimLoop(dispenser, _group.get())));
+	}
+	if (!claims.empty())
+	{
+		m_pool.SubmitBatch(claims.data(), claims.size());
+	}
+	return TaskHandle(_group);
+}
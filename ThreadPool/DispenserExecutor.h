@@ -0,0 +1,47 @@
+#ifndef __DISPENSEREXECUTOR_H__
+#define __DISPENSEREXECUTOR_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	DispenserExecutor.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	DispenserExecutor
+// Description:
+//		Frame backend which queues one claim loop per worker instead of one
+//		task per tile. Each loop takes the next tile from a shared atomic
+//		index until none are left, so tiles never go through a queue.
+//		Asynchronous, tiles are claimed in priority order and the frame can
+//		be cancelled.
+//
+
+//Local Includes
+#include "ExecutorADT.h"
+
+//Forward Declaration
+class ThreadPool;
+
+class DispenserExecutor : public ExecutorADT
+{
+public:
+	DispenserExecutor(ThreadPool& _pool) : m_pool(_pool) {};
+	virtual ~DispenserExecutor() {};
+
+	virtual TaskHandle Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group);
+	virtual ExecutorType GetType() const { return EXECUTOR_DISPENSER; };
+
+private:
+	//The DispenserExecutor is non-copyable.
+	DispenserExecutor(const DispenserExecutor& _kr) = delete;
+	DispenserExecutor& operator= (const DispenserExecutor& _kr) = delete;
+
+	//Defined in DispenserExecutor.cpp
+	struct TileDispenser;
+	class CClaimLoop;
+
+	//Member Data:
+private:
+	ThreadPool& m_pool;
+};
+
+#endif // !__DISPENSEREXECUTOR_H__
@@ -0,0 +1,139 @@
+#ifndef __EVENTCOUNT_H__
+#define __EVENTCOUNT_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	EventCount.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CEventCount
+// Description:
+//		Lets threads park until a condition they check themselves becomes
+//		true, without the notifying side taking a lock when nobody is parked.
+//		A waiter calls PrepareWait, re-checks its condition, then either
+//		CancelWait or Wait. A notifier changes the condition then calls Notify.
+//
+
+//Library Includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+//Tells the CPU we are in a spin loop
+inline void CpuRelax()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+class CEventCount
+{
+public:
+	CEventCount() {}
+
+	//Registers the caller as a waiter, the returned key is given to Wait.
+	unsigned int PrepareWait()
+	{
+		m_aiWaiters.fetch_add(1, std::memory_order_seq_cst);
+		return m_auiEpoch.load(std::memory_order_acquire);
+	}
+
+	//The condition became true after PrepareWait, don't park.
+	void CancelWait()
+	{
+		m_aiWaiters.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+	//Parks until a Notify after the matching PrepareWait.
+	void Wait(unsigned int _key)
+	{
+		{
+			std::unique_lock<std::mutex> _lock(m_mutex);
+			m_condition.wait(_lock, [this, _key] {return m_auiEpoch.load(std::memory_order_relaxed) != _key; });
+		}
+		m_aiWaiters.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+	//Parks until a Notify after the matching PrepareWait, or the time runs
+	//out. Returns false if it timed out.
+	bool WaitFor(unsigned int _key, unsigned int _milliseconds)
+	{
+		bool notified;
+		{
+			std::unique_lock<std::mutex> _lock(m_mutex);
+			notified = m_condition.wait_for(_lock, std::chrono::milliseconds(_milliseconds), [this, _key] {return m_auiEpoch.load(std::memory_order_relaxed) != _key; });
+		}
+		m_aiWaiters.fetch_sub(1, std::memory_order_seq_cst);
+		return notified;
+	}
+
+	void NotifyOne()
+	{
+		if (Advance())
+		{
+			m_condition.notify_one();
+		}
+	}
+
+	void NotifyAll()
+	{
+		if (Advance())
+		{
+			m_condition.notify_all();
+		}
+	}
+
+	//Wakes up to _count parked threads, no more than are waiting.
+	void Notify(unsigned int _count)
+	{
+		if (_count == 0 || !Advance())
+		{
+			return;
+		}
+
+		int waiters = m_aiWaiters.load(std::memory_order_relaxed);
+		for (int i = 0; i < waiters && i < static_cast<int>(_count); i++)
+		{
+			m_condition.notify_one();
+		}
+	}
+
+private:
+	//Moves the epoch on if anyone is waiting, returns whether anyone was.
+	bool Advance()
+	{
+		//Pairs with the fetch_add in PrepareWait, either the waiter sees the
+		//new condition or we see the waiter
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_aiWaiters.load(std::memory_order_relaxed) == 0)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> _lock(m_mutex);
+		m_auiEpoch.fetch_add(1, std::memory_order_release);
+		return true;
+	}
+
+	//The CEventCount is non-copyable.
+	CEventCount(const CEventCount& _kr) = delete;
+	CEventCount& operator= (const CEventCount& _kr) = delete;
+
+	std::atomic_int m_aiWaiters{ 0 };
+	std::atomic_uint m_auiEpoch{ 0 };
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+};
+
+#endif // !__EVENTCOUNT_H__
@@ -0,0 +1,154 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	ExecutorADT.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ExecutorADT (Abstract)
+// Description:
+//		An abstract data type for the backends which compute a frame's tiles.
+//		Every backend computes then colourises each tile, so the same tiles
+//		give the same output whichever one runs them.
+//
+
+//Self Include
+#include "ExecutorADT.h"
+
+//Local Includes
+#include "Task.h"
+#include "RenderJob.h"
+#include "ThreadPool.h"
+#include "PoolExecutor.h"
+#include "DispenserExecutor.h"
+#include "OpenMPExecutor.h"
+#include "ParallelExecutor.h"
+
+//	Create( _type )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Makes a backend of the given type. The pool and dispenser backends
+//		run on the default ThreadPool instance.
+//
+//	Param:
+//		- ExecutorType	|	Backend to make.
+//
+//	Return: ExecutorADT*	|	New backend, owned by the caller.
+//
+ExecutorADT* ExecutorADT::Create(ExecutorType _type)
+{
+	switch (_type)
+	{
+	case EXECUTOR_DISPENSER:
+		return new DispenserExecutor(ThreadPool::GetInstance());
+
+	case EXECUTOR_OPENMP:
+		return new OpenMPExecutor();
+
+	case EXECUTOR_PARALLEL_STL:
+		return new ParallelExecutor();
+
+	case EXECUTOR_POOL:
+	default:
+		return new PoolExecutor(ThreadPool::GetInstance());
+	}
+}
+
+//	ParseType( _name )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Converts the Executor name used by Settings.ini into an ExecutorType.
+//		Unknown names fall back to the pool.
+//
+//	Param:
+//		- std::string	|	Name of the backend.
+//
+//	Return: ExecutorType	|	Backend matching the name.
+//
+ExecutorType ExecutorADT::ParseType(const std::string& _name)
+{
+	if (_name == "Dispenser")
+	{
+		return EXECUTOR_DISPENSER;
+	}
+	if (_name == "OpenMP")
+	{
+		return EXECUTOR_OPENMP;
+	}
+	if (_name == "ParallelSTL")
+	{
+		return EXECUTOR_PARALLEL_STL;
+	}
+	return EXECUTOR_POOL;
+}
+
+//	TypeToString( _type )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Converts an ExecutorType into the name used by Settings.ini.
+//
+//	Param:
+//		- ExecutorType	|	Backend to convert.
+//
+//	Return: std::string	|	Name of the backend.
+//
+std::string ExecutorADT::TypeToString(ExecutorType _type)
+{
+	switch (_type)
+	{
+	case EXECUTOR_DISPENSER:
+		return "Dispenser";
+
+	case EXECUTOR_OPENMP:
+		return "OpenMP";
+
+	case EXECUTOR_PARALLEL_STL:
+		return "ParallelSTL";
+
+	case EXECUTOR_POOL:
+	default:
+		return "Pool";
+	}
+}
+
+//	RunTile( _tile, _group )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Computes and colourises one tile then counts it done, for backends
+//		without a task graph. The tile stops early if the group is cancelled
+//		and isn't started if it would run past the group's deadline.
+//
+//	Param:
+//		- CTask&		|	Tile to run, its group must be _group.
+//		- TaskGroup&	|	Group counting the frame's tiles.
+//
+//	Return: n/a		|
+//
+void ExecutorADT::RunTile(const CTask& _tile, TaskGroup& _group)
+{
+	bool timed = _group.HasDeadline();
+	std::chrono::steady_clock::time_point started = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+	if (_group.IsCancelled() || (timed && _group.ExpireIfLate(started)))
+	{
+		_tile.Discard();
+	}
+	else if (_tile.GetJob() != nullptr)
+	{
+		_tile();
+		if (!_tile.ColourisesItself())
+		{
+			_tile.GetJob()->ColouriseTile(_tile.GetRange());
+		}
+		if (timed)
+		{
+			_group.RecordRunTime(started);
+		}
+	}
+	_group.Done();
+}
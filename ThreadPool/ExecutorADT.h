@@ -0,0 +1,61 @@
+#ifndef __EXECUTORADT_H__
+#define __EXECUTORADT_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	ExecutorADT.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ExecutorADT (Abstract)
+// Description:
+//		An abstract data type for the backends which compute a frame's tiles.
+//		Every backend computes then colourises each tile, so the same tiles
+//		give the same output whichever one runs them.
+//
+
+//Library Includes
+#include <vector>
+#include <memory>
+#include <string>
+
+//Local Includes
+#include "TaskGroup.h"
+
+//Forward Declaration
+class CTask;
+class RenderJob;
+
+//Enums
+enum ExecutorType
+{
+	EXECUTOR_POOL, EXECUTOR_DISPENSER, EXECUTOR_OPENMP, EXECUTOR_PARALLEL_STL
+};
+
+class ExecutorADT
+{
+public:
+	//Destructor
+	virtual ~ExecutorADT() {};
+
+	//Computes and colourises every tile of _pJob, counting them in _group.
+	//Returns straight away if the backend is asynchronous, the handle
+	//completes once every tile is done.
+	virtual TaskHandle Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group) = 0;
+	virtual ExecutorType GetType() const = 0;
+
+	//Iterations a tile may run before splitting, see CTask::SetSplitBudget.
+	//Only backends which can queue more work mid frame override this.
+	virtual void SetSplitBudget(unsigned long long) {};
+
+	static ExecutorADT* Create(ExecutorType _type);
+	static ExecutorType ParseType(const std::string& _name);
+	static std::string TypeToString(ExecutorType _type);
+
+protected:
+	//Default Constructor
+	ExecutorADT() {};
+
+	static void RunTile(const CTask& _tile, TaskGroup& _group);
+};
+
+#endif // !__EXECUTORADT_H__
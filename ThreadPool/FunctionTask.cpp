@@ -0,0 +1,99 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	FunctionTask.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CFunctionTask
+// Description:
+//		Move-only task which can hold any callable. Callables of up to
+//		BUFFER_SIZE bytes are stored inline, larger ones in blocks from the
+//		CBlockPool, so submitting a task doesn't allocate once the
+//		pool has warmed up. Also carries the scheduling data the ThreadPool
+//		needs: the group, priority and an id for the trace.
+//
+
+//Self Include
+#include "FunctionTask.h"
+
+//Static Variables
+std::atomic<uint64_t> CFunctionTask::sm_aulInlineTasks{ 0 };
+std::atomic<uint64_t> CFunctionTask::sm_aulPooledTasks{ 0 };
+
+//Move Constructor
+CFunctionTask::CFunctionTask(CFunctionTask&& _other) noexcept
+{
+	*this = std::move(_other);
+}
+
+//Move Assignment
+CFunctionTask& CFunctionTask::operator=(CFunctionTask&& _other) noexcept
+{
+	if (this == &_other)
+	{
+		return *this;
+	}
+
+	Reset();
+
+	if (_other.m_pOps != nullptr)
+	{
+		if (_other.m_pOps->m_bInline)
+		{
+			_other.m_pOps->m_move(m_buffer, _other.m_buffer);
+		}
+		else
+		{
+			m_pBlock = _other.m_pBlock;
+			_other.m_pBlock = nullptr;
+		}
+		m_pOps = _other.m_pOps;
+		_other.m_pOps = nullptr;
+	}
+
+	m_pGroup = std::move(_other.m_pGroup);
+	m_fPriority = _other.m_fPriority;
+	m_eQoS = _other.m_eQoS;
+	m_iTraceX = _other.m_iTraceX;
+	m_iTraceY = _other.m_iTraceY;
+	m_ulQueuedAt = _other.m_ulQueuedAt;
+	m_bHelpable = _other.m_bHelpable;
+	return *this;
+}
+
+//Destructor
+CFunctionTask::~CFunctionTask()
+{
+	Reset();
+}
+
+//	Reset( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Destroys the callable, returns its block to the pool and drops the
+//		group, leaving an empty task.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void CFunctionTask::Reset()
+{
+	if (m_pOps != nullptr)
+	{
+		if (m_pOps->m_bInline)
+		{
+			m_pOps->m_destroy(m_buffer);
+		}
+		else
+		{
+			m_pOps->m_destroy(m_pBlock);
+			CBlockPool::Free(m_pBlock);
+			m_pBlock = nullptr;
+		}
+		m_pOps = nullptr;
+	}
+	m_pGroup = nullptr;
+}
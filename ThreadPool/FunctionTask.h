@@ -0,0 +1,170 @@
+#ifndef __FUNCTIONTASK_H__
+#define __FUNCTIONTASK_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	FunctionTask.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CFunctionTask
+// Description:
+//		Move-only task which can hold any callable. Callables of up to
+//		BUFFER_SIZE bytes are stored inline, larger ones in blocks from the
+//		CBlockPool, so submitting a task doesn't allocate once the
+//		pool has warmed up. Also carries the scheduling data the ThreadPool
+//		needs: the group, priority and an id for the trace.
+//
+
+//Library Includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Local Includes
+#include "TaskGroup.h"
+#include "BlockPool.h"
+
+class CFunctionTask
+{
+public:
+	//Largest callable stored without a pooled block
+	static const size_t BUFFER_SIZE = 64;
+
+	CFunctionTask() {};
+
+	//Wraps any callable. If it returns a number that is reported as the
+	//iterations used, and if it has a Discard() method that is called
+	//instead of running it when its group is cancelled.
+	template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, CFunctionTask>::value>::type>
+	CFunctionTask(F&& _function)
+	{
+		typedef typename std::decay<F>::type Callable;
+		if constexpr (sizeof(Callable) <= BUFFER_SIZE && alignof(Callable) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<Callable>::value)
+		{
+			new (m_buffer) Callable(std::forward<F>(_function));
+			m_pOps = &OpsFor<Callable, true>::sm_ops;
+			sm_aulInlineTasks++;
+		}
+		else
+		{
+			m_pBlock = CBlockPool::Allocate(sizeof(Callable));
+			sm_aulPooledTasks++;
+			new (m_pBlock) Callable(std::forward<F>(_function));
+			m_pOps = &OpsFor<Callable, false>::sm_ops;
+		}
+	}
+
+	CFunctionTask(CFunctionTask&& _other) noexcept;
+	CFunctionTask& operator=(CFunctionTask&& _other) noexcept;
+	~CFunctionTask();
+
+	//Runs the callable, returns the iterations it reported (0 if none).
+	unsigned long long operator()() { return m_pOps->m_invoke(Target()); };
+
+	//Called instead of running the task when its group was cancelled.
+	void Discard() { if (m_pOps) m_pOps->m_discard(Target()); };
+
+	//Destroys the callable and drops the group.
+	void Reset();
+
+	bool IsValid() const { return m_pOps != nullptr; };
+
+	void SetGroup(const std::shared_ptr<TaskGroup>& _group) { m_pGroup = _group; };
+	TaskGroup* GetGroup() const { return m_pGroup.get(); };
+	unsigned int GetGeneration() const { return m_pGroup ? m_pGroup->GetGeneration() : 0; };
+
+	void SetPriority(float _priority) { m_fPriority = _priority; };
+	float GetPriority() const { return m_fPriority; };
+
+	//Which of the pool's queues the task goes in
+	void SetQoS(QoSClass _class) { m_eQoS = _class; };
+	QoSClass GetQoS() const { return m_eQoS; };
+
+	//Shown in the task trace, tiles use their top left pixel
+	void SetTraceId(int _x, int _y) { m_iTraceX = _x; m_iTraceY = _y; };
+	int GetTraceX() const { return m_iTraceX; };
+	int GetTraceY() const { return m_iTraceY; };
+
+	//Tile sized tasks which a thread outside the pool may run while it
+	//waits. Tasks which loop over shared work, like claim loops and
+	//ParallelFor helpers, could keep that thread busy until it is all done.
+	void SetHelpable(bool _helpable) { m_bHelpable = _helpable; };
+	bool IsHelpable() const { return m_bHelpable; };
+
+	//Timestamp of when the pool queued the task, for the queue wait stat
+	void SetQueuedAt(uint64_t _timestamp) { m_ulQueuedAt = _timestamp; };
+	uint64_t GetQueuedAt() const { return m_ulQueuedAt; };
+
+	//Allocation counters, compare before and after a frame
+	static uint64_t GetInlineTasks() { return sm_aulInlineTasks; };
+	static uint64_t GetPooledTasks() { return sm_aulPooledTasks; };
+	static uint64_t GetHeapAllocations() { return CBlockPool::GetHeapAllocations(); };
+
+private:
+	//The CFunctionTask is non-copyable.
+	CFunctionTask(const CFunctionTask& _kr) = delete;
+	CFunctionTask& operator= (const CFunctionTask& _kr) = delete;
+
+	struct Ops
+	{
+		unsigned long long(*m_invoke)(void*);
+		void(*m_discard)(void*);
+		void(*m_move)(void* _to, void* _from);
+		void(*m_destroy)(void*);
+		bool m_bInline;
+	};
+
+	template<typename F, bool INLINE>
+	struct OpsFor
+	{
+		static unsigned long long Invoke(void* _p) { return Call(*static_cast<F*>(_p), std::is_void<decltype((*static_cast<F*>(_p))())>()); };
+		static void Discard(void* _p) { CallDiscard(*static_cast<F*>(_p), 0); };
+		static void Move(void* _to, void* _from) { new (_to) F(std::move(*static_cast<F*>(_from))); static_cast<F*>(_from)->~F(); };
+		static void Destroy(void* _p) { static_cast<F*>(_p)->~F(); };
+
+		static const Ops sm_ops;
+	};
+
+	template<typename F>
+	static unsigned long long Call(F& _function, std::true_type) { _function(); return 0; };
+	template<typename F>
+	static unsigned long long Call(F& _function, std::false_type) { return ToIterations(_function(), std::is_convertible<decltype(_function()), unsigned long long>()); };
+
+	template<typename R>
+	static unsigned long long ToIterations(R&& _result, std::true_type) { return static_cast<unsigned long long>(_result); };
+	template<typename R>
+	static unsigned long long ToIterations(R&&, std::false_type) { return 0; };
+
+	template<typename F>
+	static auto CallDiscard(F& _function, int) -> decltype(_function.Discard(), void()) { _function.Discard(); };
+	template<typename F>
+	static void CallDiscard(F&, long) {};
+
+	void* Target() { return (m_pOps != nullptr && m_pOps->m_bInline) ? static_cast<void*>(m_buffer) : m_pBlock; };
+
+	//Member Data:
+private:
+	alignas(std::max_align_t) unsigned char m_buffer[BUFFER_SIZE];
+	void* m_pBlock = nullptr;
+	const Ops* m_pOps = nullptr;
+
+	std::shared_ptr<TaskGroup> m_pGroup;
+	float m_fPriority = 0.0f;
+	QoSClass m_eQoS = QOS_INTERACTIVE;
+	int m_iTraceX = 0;
+	int m_iTraceY = 0;
+	uint64_t m_ulQueuedAt = 0;
+	bool m_bHelpable = false;
+
+	static std::atomic<uint64_t> sm_aulInlineTasks;
+	static std::atomic<uint64_t> sm_aulPooledTasks;
+};
+
+template<typename F, bool INLINE>
+const CFunctionTask::Ops CFunctionTask::OpsFor<F, INLINE>::sm_ops = { &Invoke, &Discard, &Move, &Destroy, INLINE };
+
+#endif // !__FUNCTIONTASK_H__
@@ -8,7 +8,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	GameScene.h
-// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	GameScene
 // Description:
 //		Contains main game loop.
@@ -23,21 +23,18 @@
 #include "ThreadPool.h"
 #include "IniParser.h"
 #include "Task.h"
+#include "Benchmark.h"
+#include "ExecutorADT.h"
+#include "CostMap.h"
 
 //Library Includes
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 //Constructor
 GameScene::GameScene()
 {
-	//Load array of pixel information
-	m_pPixels = new Pixel*[Renderer::SCREEN_WIDTH];
-	for (int i = 0; i < Renderer::SCREEN_WIDTH; i++)
-	{
-		m_pPixels[i] = new Pixel[Renderer::SCREEN_HEIGHT];
-	}
-
 	//Box vertices
 	GLfloat vertices[] = {
 		//Pos (x, y, z)			Uv(u, v)
@@ -96,20 +93,52 @@ GameScene::GameScene()
 	//Load file settings
 	LoadSettings();
 
+	//Image of the on screen view
+	bool firstTouch = IniParser::GetInstance().GetValueAsBoolean("Tread", "FirstTouch");
+	m_pView = new RenderJob(Renderer::SCREEN_WIDTH, Renderer::SCREEN_HEIGHT, IniParser::GetInstance().GetValueAsInt("Tread", "IterateLimit"), !firstTouch);
+	m_pCostMap = new CostMap();
+
+	if (firstTouch)
+	{
+		//Each worker allocates a strip of columns, so the pages are placed on its NUMA node
+		unsigned int workers = ThreadPool::GetInstance().GetWorkerCount();
+		RenderJob* view = m_pView;
+		ThreadPool::GetInstance().SetWorkerStartup([view, workers](unsigned int _index) { view->AllocateColumns(_index, workers); });
+	}
+
 	//Start Thread pool
 	ThreadPool::GetInstance().Initialize();
 	ThreadPool::GetInstance().Start();
+	ThreadPool::GetInstance().SetWorkerStartup(nullptr);
 }
 
 //Destructor
 GameScene::~GameScene()
 {
-	for (int i = 0; i < Renderer::SCREEN_WIDTH; i++)
+	//Frames already posted to the main thread queue run after this, don't let them in
+	m_pAlive = nullptr;
+
+	//Tasks write into the view, let them finish first
+	if (m_pFrameGroup)
 	{
-		delete[] m_pPixels[i];
+		m_pFrameGroup->Wait();
 	}
-	delete[] m_pPixels;
-	m_pPixels = 0;
+
+	//Nothing is waiting for the export any more, drop its tiles
+	if (m_pExportGroup)
+	{
+		m_pExportGroup->Cancel();
+	}
+	m_export.Wait();
+
+	delete m_pExecutor;
+	m_pExecutor = 0;
+
+	delete m_pView;
+	m_pView = 0;
+
+	delete m_pCostMap;
+	m_pCostMap = 0;
 
 	delete[] m_pVertices;
 	m_pVertices = 0;
@@ -343,33 +372,270 @@ void GameScene::Process(float dT)
 		float stepPerPixel = (Renderer::SCREEN_WIDTH * scale) /(Renderer::SCREEN_WIDTH);
 		SendTasks(Renderer::SCREEN_WIDTH * scale, Renderer::SCREEN_HEIGHT * scale, scale);
 	}
-	else
+	else if (m_uiHelpMilliseconds > 0 && m_pFrameGroup && !m_pFrameGroup->IsComplete())
+	{
+		//Compute tiles here rather than sleep, but get back in time to redraw
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_uiHelpMilliseconds);
+		ThreadPool::GetInstance().HelpWhileWaiting(m_pFrameGroup, deadline);
+	}
+	//Otherwise RenderFrame carries the frame through to OnFrameComplete.
+}
+
+//	RenderFrame( _frameGroup, _frame )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Uploads a frame once its graph is done. Every colourise node is a
+//		predecessor of the upload, which runs on the main thread. A
+//		cancelled frame, or one whose scene was deleted while it was on its
+//		way to the main thread, is never uploaded.
+//		
+//	Param:
+//		- std::shared_ptr<TaskGroup>	|	Group counting the frame's graph nodes.
+//		- unsigned int					|	Number of the frame.
+//
+//	Return: CoTask	|	Completes once the frame is on screen or dropped.
+//
+CoTask GameScene::RenderFrame(std::shared_ptr<TaskGroup> _frameGroup, unsigned int _frame)
+{
+	//Taken on the main thread, nothing of the scene is touched off it
+	std::weak_ptr<bool> alive = m_pAlive;
+
+	co_await WhenAll(_frameGroup);
+	if (_frameGroup->IsCancelled())
+	{
+		co_return;
+	}
+
+	//Only the main thread deletes the scene, so it can't go after this check
+	co_await ResumeOnMainThread();
+	if (alive.expired())
+	{
+		co_return;
+	}
+	OnFrameComplete(_frame);
+}
+
+//	OnFrameComplete( _frame )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Called on the main thread once every tile of a frame has been
+//		colourised. Uploads the pixels to the screen texture, unless a newer
+//		frame has been sent since.
+//		
+//	Param:
+//		- unsigned int	|	Number of the frame which finished.
+//
+//	Return: n/a		|
+//
+void GameScene::OnFrameComplete(unsigned int _frame)
+{
+	if (!m_IsTiming || _frame != m_uiFrameCount)
+	{
+		//Stale frame
+		return;
+	}
+
+	if (m_uiPassStride > 0)
+	{
+		//Show whatever the pass finished in time
+		Renderer::GetInstance().SetTexture("Render", m_pView->GetOutput());
+		m_uiProgressiveFrames++;
+
+		size_t left = std::count(m_tileDone.begin(), m_tileDone.end(), static_cast<unsigned char>(0));
+		std::cout << "[MAIN THREAD]: Progressive frame " << m_uiProgressiveFrames << ", stride " << m_uiPassStride << ": ";
+		std::cout << (m_tileDone.size() - left) << " of " << m_tileDone.size() << " tiles done, " << m_pFrameGroup->GetTasksExpired() << " expired." << std::endl;
+
+		//Carry on with the same pass until every tile is done, then refine
+		if (left == 0)
+		{
+			m_uiPassStride /= 2;
+			m_tileDone.assign(m_tileDone.size(), 0);
+		}
+		if (m_uiPassStride > 0)
+		{
+			SendPass();
+			return;
+		}
+		std::cout << "[MAIN THREAD]: Converged after " << m_uiProgressiveFrames << " frames." << std::endl;
+	}
+
+	m_endWork = std::chrono::high_resolution_clock::now();
+	auto time = std::chrono::duration_cast<std::chrono::microseconds>(m_endWork - m_startWork).count();
+	float seconds = time / 1000000.0f;
+	m_IsTiming = false;
+	std::cout << "[MAIN THREAD]: Tasks finished! Total Time Taken: " << seconds << " seconds." << std::endl;
+	std::cout << "[MAIN THREAD]: Task allocations this frame: " << (CFunctionTask::GetHeapAllocations() - m_ulAllocationsAtSend) << std::endl;
+
+	//How evenly the frame was spread over the workers
+	ThreadPool::GetInstance().GetStats().Print("MAIN THREAD");
+
+	//How well the last view predicted this one
+	if (m_pView->GetCostMap() != nullptr && m_dPredictedIterations > 0.0)
+	{
+		uint64_t iterations = m_pCostMap->GetRecordedIterations();
+		std::cout << "[MAIN THREAD]: Cost map predicted " << static_cast<uint64_t>(m_dPredictedIterations) << " iterations, tiles ran " << iterations;
+		std::cout << " in " << m_pCostMap->GetRecordedNanoseconds() / 1000000.0 << " ms of tile time." << std::endl;
+	}
+
+	//Histogram pass: how much of the view escaped
+	Range2D screen = m_pView->GetBounds();
+	long long divergent = ThreadPool::GetInstance().ParallelReduce(screen, sm_parallelGrain, 0LL, [&](const Range2D& _chunk, long long& _count)
 	{
-		if (m_IsTiming)
+		for (int i = _chunk.m_iBeginX; i < _chunk.m_iEndX; i++)
 		{
-			if (!ThreadPool::GetInstance().HasItemsRemaining())
+			for (int j = _chunk.m_iBeginY; j < _chunk.m_iEndY; j++)
 			{
-				m_endWork = std::chrono::high_resolution_clock::now();
-				auto time = std::chrono::duration_cast<std::chrono::microseconds>(m_endWork - m_startWork).count();
-				float seconds = time / 1000000.0f;
-				m_IsTiming = false;
-				std::cout << "[MAIN THREAD]: Tasks finished! Total Time Taken: " << seconds << " seconds." << std::endl;
-
-				unsigned char* pixels = new unsigned char[Renderer::SCREEN_WIDTH * Renderer::SCREEN_HEIGHT * 4];
-				for(unsigned int i = 0; i < Renderer::SCREEN_WIDTH; i++)
-				{
-					for (unsigned int j = 0; j < Renderer::SCREEN_HEIGHT; j++)
-					{
-						pixels[((i * Renderer::SCREEN_HEIGHT + j) * 4) + 0] = 0xFF;//(!m_pPixels[i][j].IsDivergent) ? 0xFF : 0x00;
-						pixels[((i * Renderer::SCREEN_HEIGHT + j) * 4) + 1] = 0xFF; //(!m_pPixels[i][j].IsDivergent) ? 0xFF : 0x00;
-						pixels[((i * Renderer::SCREEN_HEIGHT + j) * 4) + 2] = 0xFF; //(!m_pPixels[i][j].IsDivergent) ? 0xFF : 0x00;
-						pixels[((i * Renderer::SCREEN_HEIGHT + j) * 4) + 3] = m_pPixels[i][j].alpha; //(!m_pPixels[i][j].IsDivergent) ? 0xFF : 0x00;
-					}
-				}
-				Renderer::GetInstance().SetTexture("Render", pixels);
-				delete[] pixels;
+				_count += m_pView->GetPixel(i, j).IsDivergent ? 1 : 0;
 			}
 		}
+	}, [](long long _a, long long _b) { return _a + _b; });
+	std::cout << "[MAIN THREAD]: " << (100.0 * divergent) / screen.Area() << "% of pixels diverged." << std::endl;
+
+	Renderer::GetInstance().SetTexture("Render", m_pView->GetOutput());
+}
+
+//	CancelFrame( )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Cancels the frame in flight, if any. Queued tiles are dropped and
+//		running tiles stop at their next line, this waits for them so nothing
+//		writes into the view afterwards. Prints what the cancellation saved.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: n/a		|
+//
+void GameScene::CancelFrame()
+{
+	if (!m_pFrameGroup || m_pFrameGroup->IsComplete())
+	{
+		return;
+	}
+
+	m_pFrameGroup->Cancel();
+	m_pFrameGroup->Wait();
+	m_IsTiming = false;
+
+	std::cout << "[MAIN THREAD]: Cancelled generation " << m_pFrameGroup->GetGeneration() << ": ";
+	std::cout << m_pFrameGroup->GetTasksDropped() << " tiles dropped, " << m_pFrameGroup->GetTasksStopped() << " stopped early, ";
+	std::cout << m_pFrameGroup->GetPixelsSkipped() << " pixels and ~" << m_pFrameGroup->EstimateIterationsSaved(m_pView->GetIterationLimit()) << " iterations saved." << std::endl;
+}
+
+//	StartExport( )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Starts computing the current view at ExportScale times the
+//		resolution as background work. Frames keep priority over it, the
+//		image is saved once every tile is done. Only one export runs at once.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: n/a		|
+//
+void GameScene::StartExport()
+{
+	if (!m_export.IsComplete())
+	{
+		std::cout << "[MAIN THREAD]: Export already running." << std::endl;
+		return;
+	}
+
+	int scale = IniParser::GetInstance().GetValueAsInt("Tread", "ExportScale");
+	scale = (scale > 0) ? scale : 1;
+	const int divisions = IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount") * scale;
+
+	//Same view with smaller pixels, a worker allocates the columns
+	std::shared_ptr<RenderJob> job = std::make_shared<RenderJob>(m_pView->GetWidth() * scale, m_pView->GetHeight() * scale, m_pView->GetIterationLimit(), false);
+	job->SetView(m_pView->GetLeft(), m_pView->GetTop(), m_pView->GetPixelWidth() / scale, m_pView->GetPixelHeight() / scale);
+
+	m_pExportGroup = std::make_shared<TaskGroup>();
+	m_pExportGroup->SetQoS(QOS_BACKGROUND);
+
+	std::cout << "[MAIN THREAD]: Exporting " << job->GetWidth() << "x" << job->GetHeight() << " in the background..." << std::endl;
+	m_export = ExportView(job, m_pExportGroup, divisions, "Resources/Files/Export.pgm");
+}
+
+//	ExportView( _job, _tiles, _divisions, _path )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Computes an export job entirely as background work and saves it.
+//		The tiles are queued a slice at a time so the background queue
+//		stays under the pool's bound. Stops without saving if cancelled.
+//		
+//	Param:
+//		- std::shared_ptr<RenderJob>	|	Job to compute, columns not yet allocated.
+//		- std::shared_ptr<TaskGroup>	|	Background group, cancelling it drops the tiles.
+//		- int							|	Number of divisions along each axis.
+//		- std::string					|	File to save the image to.
+//
+//	Return: CoTask	|	Completes once the image is saved or dropped.
+//
+CoTask GameScene::ExportView(std::shared_ptr<RenderJob> _job, std::shared_ptr<TaskGroup> _tiles, int _divisions, std::string _path)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	ThreadPool& pool = ThreadPool::GetInstance();
+
+	//Set up on a worker, behind any interactive work
+	co_await pool.Schedule(QOS_BACKGROUND);
+	_job->AllocateColumns(0, 1);
+	_job->ResetPixels(_job->GetBounds());
+
+	std::vector<CTask> tasks;
+	_job->CreateTasks(_divisions, tasks);
+
+	//Submits from a worker skip the queue bound, so the tiles go in a
+	//slice at a time. Two slices are in flight, so the queue stays under
+	//the bound without the workers running dry between slices.
+	const size_t maxQueued = pool.GetMaxQueued();
+	const size_t slice = (maxQueued > 0) ? std::max<size_t>(maxQueued / 2, 1) : tasks.size();
+	std::shared_ptr<TaskGroup> slices[2];
+	for (size_t first = 0, i = 0; first < tasks.size() && !_tiles->IsCancelled(); first += slice, i++)
+	{
+		std::shared_ptr<TaskGroup>& group = slices[i % 2];
+		if (group)
+		{
+			co_await WhenAll(group);
+		}
+
+		group = std::make_shared<TaskGroup>();
+		group->SetQoS(QOS_BACKGROUND);
+		group->SetParent(_tiles);
+		pool.SubmitBatch(tasks.data() + first, std::min(slice, tasks.size() - first), group);
+	}
+
+	for (std::shared_ptr<TaskGroup>& group : slices)
+	{
+		if (group)
+		{
+			co_await WhenAll(group);
+		}
+	}
+	if (_tiles->IsCancelled())
+	{
+		co_return;
+	}
+
+	bool saved = _job->SaveImage(_path);
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+	if (saved)
+	{
+		std::cout << "[EXPORT]: Saved " << _path << " after " << elapsed.count() << "ms." << std::endl;
+	}
+	else
+	{
+		std::cout << "[EXPORT]: Couldn't write " << _path << "." << std::endl;
 	}
 }
 
@@ -388,11 +654,21 @@ void GameScene::Process(float dT)
 //
 void GameScene::SendTasks(float width, float height, float stepPerPixel)
 {
-	//Mandlebrot constants
-	float ReMin = 0.0f;
-	float ReMax = 4.0f;
-	float ImMin = -0.0f;
-	float ImMax = 4.0f;
+	//Cancel the previous view if it is still being computed
+	CancelFrame();
+
+	//Switch backend if the settings asked for another, nothing is running on it now
+	ExecutorType executor = ExecutorADT::ParseType(IniParser::GetInstance().GetValueAsString("Tread", "Executor"));
+	if (m_pExecutor == nullptr || m_pExecutor->GetType() != executor)
+	{
+		delete m_pExecutor;
+		m_pExecutor = ExecutorADT::Create(executor);
+		std::cout << "[MAIN THREAD]: Computing tiles with " << ExecutorADT::TypeToString(executor) << "." << std::endl;
+	}
+
+	//Tiles in expensive areas split once they run past this many iterations
+	int splitBudget = IniParser::GetInstance().GetValueAsInt("Tread", "SplitIterations");
+	m_pExecutor->SetSplitBudget((splitBudget > 0) ? splitBudget : 0);
 
 	//Calcuate the offset
 	float originX = m_origin.x * (Renderer::SCREEN_WIDTH / 2.0f);
@@ -400,32 +676,33 @@ void GameScene::SendTasks(float width, float height, float stepPerPixel)
 
 	std::cout << "[MAIN THREAD]: Generating Data..." << std::endl;
 
-	//Update Pixel information
-	for (int i = 0; i < Renderer::SCREEN_WIDTH; i++)
+	RenderJob* view = m_pView;
+	view->FitView(width, height, stepPerPixel, originX, originY);
+
+	//Move the last view's costs onto this one, nothing is recording into the map now
+	const std::string schedule = IniParser::GetInstance().GetValueAsString("Tread", "CostSchedule");
+	const bool useCostMap = (schedule == "LPT" || schedule == "Balanced");
+	view->SetCostMap(useCostMap ? m_pCostMap : nullptr);
+	if (useCostMap)
 	{
-		for (int j = 0; j < Renderer::SCREEN_HEIGHT; j++)
-		{
-			//Calculate the current cordinates at pixel location.
-			float x = (-width / 2.0f) + originX + (i * stepPerPixel);
-			float y = (height / 2.0f) + originY - (j * stepPerPixel);
-
-			//Complex number for this pixel
-			m_pPixels[i][j].c = Complex(
-				(ReMin + (x / (float)(width)) * (ReMax - ReMin)) * stepPerPixel,
-				(ImMin + (y / (float)(height)) * (ImMax - ImMin)) * stepPerPixel
-			);
-
-			//Reset iteration variables
-			m_pPixels[i][j].IsDivergent = false;
-			m_pPixels[i][j].alpha = 0xFF;
-		}
+		m_pCostMap->Reproject(*view);
 	}
 
+	//Update Pixel information, split across the pool
+	ThreadPool::GetInstance().ParallelFor(view->GetBounds(), sm_parallelGrain, [view](const Range2D& _chunk)
+	{
+		view->ResetPixels(_chunk);
+	});
+
 	//Get Divisions from the file.
 	const int divisions = IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount");
 
+	//How long the main thread may spend on tiles between redraws
+	int help = IniParser::GetInstance().GetValueAsInt("Tread", "MainThreadHelpMs");
+	m_uiHelpMilliseconds = (help > 0) ? help : 0;
+
 	//Get Limit and accuracy from the file.
-	CTask::LIMIT = IniParser::GetInstance().GetValueAsInt("Tread", "IterateLimit");
+	view->SetIterationLimit(IniParser::GetInstance().GetValueAsInt("Tread", "IterateLimit"));
 
 	//Get colour information from the file.
 	m_pixelColor.r = IniParser::GetInstance().GetValueAsInt("Colour", "R") / 255.0f;
@@ -434,38 +711,151 @@ void GameScene::SendTasks(float width, float height, float stepPerPixel)
 
 	//Safety checks:
 	assert(divisions > 0);
-	assert(CTask::LIMIT != 0);
+	assert(view->GetIterationLimit() != 0);
 
 	//Get reference to ThreadPool
 	ThreadPool& threadPool = ThreadPool::GetInstance();
 
-	int sizeX = (Renderer::SCREEN_WIDTH) / divisions;
-	int sizeY = (Renderer::SCREEN_HEIGHT) / divisions;
-
-	std::cout << "[MAIN THREAD]: Sending Data Packets..." << std::endl;
+	//Fixed size tiles cover the image exactly, otherwise use the division grid
+	const int tileWidth = IniParser::GetInstance().GetValueAsInt("Tread", "TileWidth");
+	const int tileHeight = IniParser::GetInstance().GetValueAsInt("Tread", "TileHeight");
 
-	//// The main thread writes items to the WorkQueue
-	for (int i = 0; i < divisions + 1; i++)
+	std::vector<CTask> tasks;
+	if (schedule == "Balanced" && m_pCostMap->HasEstimate())
 	{
-		//X coordinate start
-		int startX = i * sizeX;
-
-		for (int j = 0; j < divisions + 1; j++)
-		{
-			//Y coordinate start
-			int startY = j * sizeY;
-			
-			//Send task
-			threadPool.Submit(CTask(startX, startY, sizeX, sizeY));
-		}
+		//Tiles of about equal predicted cost, small where the set is expensive
+		m_pCostMap->CreateBalancedTiles(*view, divisions * divisions, tasks);
+	}
+	else if (tileWidth > 0 && tileHeight > 0)
+	{
+		view->CreateTiles(tileWidth, tileHeight, tasks);
 	}
+	else
+	{
+		view->CreateTasks(divisions, tasks);
+	}
+
+	std::cout << "[MAIN THREAD]: Sending Data Packets..." << std::endl;
+
+	//Decide which tiles should be computed first, longest first with a cost map
+	PriorityFunction tileOrder = useCostMap ? m_pCostMap->LongestFirst() : GetTileOrder(static_cast<float>((tileWidth > 0 && tileHeight > 0) ? tileWidth : Renderer::SCREEN_WIDTH / divisions));
 
 	//Start Timer
 	m_startWork = std::chrono::high_resolution_clock::now();
+	m_ulAllocationsAtSend = CFunctionTask::GetHeapAllocations();
+	threadPool.ResetStats();
+
+	for (size_t i = 0; i < tasks.size(); i++)
+	{
+		tasks[i].SetPriority(tileOrder ? tileOrder(tasks[i]) : 0.0f);
+	}
+
+	if (useCostMap)
+	{
+		//FIFO queues ignore priorities, so hand them the tiles longest first too
+		std::stable_sort(tasks.begin(), tasks.end(), [](const CTask& _a, const CTask& _b) { return _a.GetPriority() < _b.GetPriority(); });
+		m_dPredictedIterations = m_pCostMap->HasEstimate() ? m_pCostMap->Estimate(view->GetBounds()) : 0.0;
+	}
 
 	//Update conditions
 	m_IsTiming = true;
 	m_HasWorkSent = true;
+
+	//With a frame budget the view is shown coarse first and refined over
+	//the following frames, each pass getting what the budget allows
+	int budget = IniParser::GetInstance().GetValueAsInt("Tread", "FrameBudgetMs");
+	m_uiFrameBudgetMs = (budget > 0) ? budget : 0;
+	if (m_uiFrameBudgetMs > 0)
+	{
+		int stride = IniParser::GetInstance().GetValueAsInt("Tread", "ProgressiveStride");
+		m_uiCoarsestStride = 1;
+		while (static_cast<int>(m_uiCoarsestStride) * 2 <= stride)
+		{
+			m_uiCoarsestStride *= 2;
+		}
+
+		m_progressiveTiles = std::move(tasks);
+		m_tileDone.assign(m_progressiveTiles.size(), 0);
+		m_uiPassStride = m_uiCoarsestStride;
+		m_uiProgressiveFrames = 0;
+		SendPass();
+		return;
+	}
+	m_uiPassStride = 0;
+
+	//Every tile is computed then colourised, the upload waits for them all
+	m_pFrameGroup = std::make_shared<TaskGroup>();
+	m_pExecutor->Dispatch(view, tasks, m_pFrameGroup);
+
+	RenderFrame(m_pFrameGroup, ++m_uiFrameCount);
+}
+
+//	SendPass( )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Sends the tiles the current progressive pass hasn't finished, due by
+//		the end of the frame budget. The pool doesn't start tiles which
+//		wouldn't be done in time, they are sent again next frame. The frame
+//		is uploaded once the finished tiles are colourised.
+//		
+//	Param:
+//		- n/a		|
+//
+//	Return: n/a		|
+//
+void GameScene::SendPass()
+{
+	std::vector<CTask> tiles;
+	tiles.reserve(m_progressiveTiles.size());
+	for (size_t i = 0; i < m_progressiveTiles.size(); i++)
+	{
+		if (m_tileDone[i] == 0)
+		{
+			CTask tile(m_progressiveTiles[i]);
+			tile.SetPass(m_uiPassStride, m_uiPassStride == m_uiCoarsestStride);
+			tile.SetDoneFlag(&m_tileDone[i]);
+			tiles.push_back(tile);
+		}
+	}
+
+	m_pFrameGroup = std::make_shared<TaskGroup>();
+	m_pFrameGroup->SetDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(m_uiFrameBudgetMs));
+	m_pExecutor->Dispatch(m_pView, tiles, m_pFrameGroup);
+
+	RenderFrame(m_pFrameGroup, ++m_uiFrameCount);
+}
+
+//	GetTileOrder( _tileSize )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Builds the priority function named by TileOrder in the settings file.
+//		"Cursor" computes the tiles nearest the mouse first, "Spiral" grows
+//		the image outwards from the centre of the screen and "None" keeps the
+//		submission order.
+//		
+//	Param:
+//		- float		|	Width of a tile in pixels.
+//
+//	Return: PriorityFunction	|	Function for the ThreadPool, may be empty.
+//
+PriorityFunction GameScene::GetTileOrder(float _tileSize)
+{
+	std::string order = IniParser::GetInstance().GetValueAsString("Tread", "TileOrder");
+
+	if (order == "Cursor")
+	{
+		glm::vec2 mouse = InputHandler::GetInstance().GetMousePos();
+		return TilePriority::DistanceFromPoint(mouse.x, mouse.y);
+	}
+	if (order == "Spiral")
+	{
+		return TilePriority::SpiralCenterOut(Renderer::SCREEN_WIDTH / 2.0f, Renderer::SCREEN_HEIGHT / 2.0f, _tileSize);
+	}
+	return nullptr;
 }
 
 //	LoadSettings( )
@@ -484,21 +874,49 @@ void GameScene::SendTasks(float width, float height, float stepPerPixel)
 void GameScene::LoadSettings()
 {
 	//Load file
-	if (!IniParser::GetInstance().LoadIniFile("Resources/Files/Settings.ini"))
+	bool isNewFile = !IniParser::GetInstance().LoadIniFile("Resources/Files/Settings.ini");
+	if (isNewFile)
 	{
 		//If file doesn't exist, create it:
 		IniParser::GetInstance().CreateIniFile("Resources/Files/Settings.ini");
+	}
 
-		IniParser::GetInstance().AddNewValue("Tread", "ThreadCount", "8");
-		IniParser::GetInstance().AddNewValue("Tread", "WorkDivisionsCount", "20");
-		IniParser::GetInstance().AddNewValue("Tread", "IterateLimit", "30");
-
-		IniParser::GetInstance().AddNewValue("Colour", "R", "255");
-		IniParser::GetInstance().AddNewValue("Colour", "G", "255");
-		IniParser::GetInstance().AddNewValue("Colour", "B", "255");
-
-		IniParser::GetInstance().AddNewValue("Window", "Size", "900");
-
+	//Defaults, existing values in the file are not replaced.
+	IniParser::GetInstance().AddNewValue("Tread", "ThreadCount", "8");
+	IniParser::GetInstance().AddNewValue("Tread", "QueueType", "Shared");
+	IniParser::GetInstance().AddNewValue("Tread", "QueueCapacity", "4096");
+	IniParser::GetInstance().AddNewValue("Tread", "MaxQueuedTasks", "4096");
+	IniParser::GetInstance().AddNewValue("Tread", "TileOrder", "Spiral");
+	IniParser::GetInstance().AddNewValue("Tread", "WorkDivisionsCount", "20");
+	IniParser::GetInstance().AddNewValue("Tread", "IterateLimit", "30");
+	IniParser::GetInstance().AddNewValue("Tread", "PopBatchSize", "4");
+	IniParser::GetInstance().AddNewValue("Tread", "TraceBufferSize", "4096");
+	IniParser::GetInstance().AddNewValue("Tread", "Affinity", "None");
+	IniParser::GetInstance().AddNewValue("Tread", "SkipSMT", "false");
+	IniParser::GetInstance().AddNewValue("Tread", "FirstTouch", "false");
+	IniParser::GetInstance().AddNewValue("Tread", "IdleSpinCount", "1000");
+	IniParser::GetInstance().AddNewValue("Tread", "IdleYieldCount", "8");
+	IniParser::GetInstance().AddNewValue("Tread", "MinThreadCount", "1");
+	IniParser::GetInstance().AddNewValue("Tread", "IdleRetireMs", "5000");
+	IniParser::GetInstance().AddNewValue("Tread", "BackgroundEvery", "0");
+	IniParser::GetInstance().AddNewValue("Tread", "ExportScale", "2");
+	IniParser::GetInstance().AddNewValue("Tread", "Executor", "Pool");
+	IniParser::GetInstance().AddNewValue("Tread", "SplitIterations", "0");
+	IniParser::GetInstance().AddNewValue("Tread", "TileWidth", "0");
+	IniParser::GetInstance().AddNewValue("Tread", "TileHeight", "0");
+	IniParser::GetInstance().AddNewValue("Tread", "CostSchedule", "None");
+	IniParser::GetInstance().AddNewValue("Tread", "FrameBudgetMs", "0");
+	IniParser::GetInstance().AddNewValue("Tread", "ProgressiveStride", "8");
+	IniParser::GetInstance().AddNewValue("Tread", "MainThreadHelpMs", "12");
+
+	IniParser::GetInstance().AddNewValue("Colour", "R", "255");
+	IniParser::GetInstance().AddNewValue("Colour", "G", "255");
+	IniParser::GetInstance().AddNewValue("Colour", "B", "255");
+
+	IniParser::GetInstance().AddNewValue("Window", "Size", "900");
+
+	if (isNewFile)
+	{
 		IniParser::GetInstance().SaveIniFile();
 	}
 }
@@ -611,6 +1029,104 @@ void GameScene::OnKeyChange()
 		m_tempPos = glm::vec2(0.0f, 0.0f);
 		m_origin = glm::vec2(0.0f, 0.0f);
 		m_HasWorkSent = false;
+
+		//Pick up changes to the settings file, including the thread count
+		LoadSettings();
+		int count = IniParser::GetInstance().GetValueAsInt("Tread", "ThreadCount");
+		ThreadPool::GetInstance().Resize((count > 0) ? count : std::thread::hardware_concurrency());
+		std::cout << "[MAIN THREAD]: Settings reloaded, " << ThreadPool::GetInstance().GetWorkerCount() << " workers." << std::endl;
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('-') || InputHandler::GetInstance().IsKeyPressedFirst('_'))
+	{
+		//One worker fewer
+		ThreadPool::GetInstance().Resize(ThreadPool::GetInstance().GetWorkerCount() - 1);
+		std::cout << "[MAIN THREAD]: " << ThreadPool::GetInstance().GetWorkerCount() << " workers." << std::endl;
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('=') || InputHandler::GetInstance().IsKeyPressedFirst('+'))
+	{
+		//One worker more
+		ThreadPool::GetInstance().Resize(ThreadPool::GetInstance().GetWorkerCount() + 1);
+		std::cout << "[MAIN THREAD]: " << ThreadPool::GetInstance().GetWorkerCount() << " workers." << std::endl;
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('b') || InputHandler::GetInstance().IsKeyPressedFirst('B'))
+	{
+		//Benchmark the current view, only once the frame is finished
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			std::vector<CTask> tasks;
+			m_pView->CreateTasks(IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"), tasks);
+			Benchmark::RunContention(tasks);
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('n') || InputHandler::GetInstance().IsKeyPressedFirst('N'))
+	{
+		//Benchmark pinned against unpinned workers, only once the frame is finished
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			std::vector<CTask> tasks;
+			m_pView->CreateTasks(IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"), tasks);
+			Benchmark::RunAffinity(tasks);
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('x') || InputHandler::GetInstance().IsKeyPressedFirst('X'))
+	{
+		//Benchmark every executor backend and tile size on the current view,
+		//and check warmed up frames make no task heap allocations
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			Benchmark::RunExecutors(*m_pView, IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"));
+			Benchmark::RunTileSizes(*m_pView, IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"));
+			Benchmark::RunAllocations(*m_pView, IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"));
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('c') || InputHandler::GetInstance().IsKeyPressedFirst('C'))
+	{
+		//Benchmark longest first and cost balanced tiles against the grid
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			Benchmark::RunCostMap(*m_pView, IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"));
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('l') || InputHandler::GetInstance().IsKeyPressedFirst('L'))
+	{
+		//Benchmark how quickly idle workers pick up new tasks
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			Benchmark::RunWakeLatency();
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('e') || InputHandler::GetInstance().IsKeyPressedFirst('E'))
+	{
+		//Save the current view at a higher resolution without holding up the frames
+		if (m_HasWorkSent)
+		{
+			StartExport();
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('q') || InputHandler::GetInstance().IsKeyPressedFirst('Q'))
+	{
+		//Benchmark frame times while background work fills the pool
+		if (m_HasWorkSent && !m_IsTiming)
+		{
+			std::vector<CTask> tasks;
+			m_pView->CreateTasks(IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount"), tasks);
+			Benchmark::RunQoS(tasks);
+		}
+	}
+
+	if (InputHandler::GetInstance().IsKeyPressedFirst('t') || InputHandler::GetInstance().IsKeyPressedFirst('T'))
+	{
+		//Dump the task trace for chrome://tracing
+		ThreadPool::GetInstance().ExportTrace("Resources/Files/Trace.json");
 	}
 
 	if (InputHandler::GetInstance().IsKeyPressed('z') || InputHandler::GetInstance().IsKeyPressed('Z'))
@@ -640,20 +1156,3 @@ void GameScene::OnSpecialChange()
 {
 	//Do nothing
 }
-
-//	GetPixel( i, j )
-//
-//	Author: Michael Jordan
-//	Access: public
-//	Description:
-//		Gets a reference to the pixel at screen location ( i, j ).
-//		
-//	Param:
-//		- n/a		|
-//
-//	Return: Pixel&	|	reference to ( i, j ) pixel.
-//
-Pixel& GameScene::GetPixel(int i, int j)
-{
-	return m_pPixels[i][j];
-}
@@ -10,7 +10,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	GameScene.h
-// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	GameScene
 // Description:
 //		Contains main game loop.
@@ -21,16 +21,21 @@
 #include "Complex.h"
 #include "TextGenerator.h"
 #include "Texture.h"
+#include "TilePriority.h"
+#include "Range2D.h"
+#include "RenderJob.h"
+#include "Coroutine.h"
 
 //Library Includes
 #include <Chrono>
+#include <vector>
+#include <memory>
 
-struct Pixel
-{
-	Complex c = Complex(0.0f, 0.0f);
-	bool IsDivergent = true;
-	unsigned char alpha = 0xFF;
-};
+//Forward Declaration
+class CTask;
+class TaskGroup;
+class ExecutorADT;
+class CostMap;
 
 class GameScene : public SceneADT
 {
@@ -48,8 +53,6 @@ public:
 	virtual void OnMouseWheelChange();
 	virtual void OnKeyChange();
 	virtual void OnSpecialChange();
-
-	Pixel& GetPixel(int i, int j);
 	
 protected:
 	void SetUpBorder();
@@ -57,6 +60,13 @@ protected:
 	void DrawBorder();
 
 	void SendTasks(float width, float height, float stepPerPixel);
+	PriorityFunction GetTileOrder(float _tileSize);
+	CoTask RenderFrame(std::shared_ptr<TaskGroup> _frameGroup, unsigned int _frame);
+	void OnFrameComplete(unsigned int _frame);
+	void CancelFrame();
+	void SendPass();
+	void StartExport();
+	CoTask ExportView(std::shared_ptr<RenderJob> _job, std::shared_ptr<TaskGroup> _tiles, int _divisions, std::string _path);
 
 private:
 	
@@ -69,6 +79,46 @@ protected:
 
 	bool m_HasWorkSent = false;
 	bool m_IsTiming = false;
+
+	//Tasks of the frame currently being computed
+	std::shared_ptr<TaskGroup> m_pFrameGroup;
+
+	//Longest the main thread runs tiles for between redraws, 0 to not help
+	unsigned int m_uiHelpMilliseconds = 0;
+
+	//Backend computing the frame's tiles, picked by the Executor setting
+	ExecutorADT* m_pExecutor = nullptr;
+
+	//Expires with the scene, a frame resumed on the main thread after the
+	//scene is gone checks it rather than touching the scene
+	std::shared_ptr<bool> m_pAlive = std::make_shared<bool>(true);
+
+	//Image shown on screen, its output is uploaded to the screen texture
+	RenderJob* m_pView;
+	unsigned int m_uiFrameCount = 0;
+
+	//Progressive rendering, see FrameBudgetMs. Tiles of the view, which of
+	//them the current pass has finished and its stride, 0 once converged.
+	std::vector<CTask> m_progressiveTiles;
+	std::vector<unsigned char> m_tileDone;
+	unsigned int m_uiPassStride = 0;
+	unsigned int m_uiCoarsestStride = 1;
+	unsigned int m_uiFrameBudgetMs = 0;
+	unsigned int m_uiProgressiveFrames = 0;
+
+	//Cost of the last view, predicts the next one's for CostSchedule
+	CostMap* m_pCostMap = nullptr;
+	double m_dPredictedIterations = 0.0;
+
+	//Higher resolution copy of the view computed as background work
+	CoTask m_export;
+	std::shared_ptr<TaskGroup> m_pExportGroup;
+
+	//Fewest pixels given to one chunk of a ParallelFor
+	static const unsigned int sm_parallelGrain = 4096;
+
+	//Task heap allocations counted when the frame was sent
+	unsigned long long m_ulAllocationsAtSend = 0;
 	
 	GLuint m_program;
 	GLuint m_VAO_ID;
@@ -93,7 +143,6 @@ protected:
 
 	glm::vec2 m_origin = glm::vec2(0, 0);
 	glm::vec2 m_tempPos = glm::vec2(0, 0);
-	Pixel** m_pPixels;
 
 	Texture* m_texture;
 private:
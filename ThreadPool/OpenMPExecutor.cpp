@@ -0,0 +1,51 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	OpenMPExecutor.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	OpenMPExecutor
+// Description:
+//		Frame backend running the tiles in an OpenMP parallel for with a
+//		dynamic schedule. Blocks until the frame is done. Without OpenMP
+//		support the tiles run one after another on the calling thread.
+//
+
+//Self Include
+#include "OpenMPExecutor.h"
+
+//Local Includes
+#include "Task.h"
+
+//	Dispatch( _pJob, _tiles, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Runs every tile, one at a time per OpenMP thread in the order given.
+//		Priorities are ignored. Returns once the frame is done.
+//
+//	Param:
+//		- RenderJob*					|	Image the tiles belong to.
+//		- std::vector<CTask>&			|	Tiles of the frame.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tiles in.
+//
+//	Return: TaskHandle	|	Handle of the group, already complete.
+//
+TaskHandle OpenMPExecutor::Dispatch(RenderJob*, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group)
+{
+	//OpenMP 2.0 loops need a signed index
+	int count = static_cast<int>(_tiles.size());
+	_group->Add(count);
+	for (int i = 0; i < count; i++)
+	{
+		_tiles[i].SetGroup(_group);
+	}
+
+	TaskGroup& group = *_group;
+#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < count; i++)
+	{
+		RunTile(_tiles[i], group);
+	}
+	return TaskHandle(_group);
+}
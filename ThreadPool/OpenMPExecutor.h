@@ -0,0 +1,29 @@
+#ifndef __OPENMPEXECUTOR_H__
+#define __OPENMPEXECUTOR_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	OpenMPExecutor.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	OpenMPExecutor
+// Description:
+//		Frame backend running the tiles in an OpenMP parallel for with a
+//		dynamic schedule. Blocks until the frame is done. Without OpenMP
+//		support the tiles run one after another on the calling thread.
+//
+
+//Local Includes
+#include "ExecutorADT.h"
+
+class OpenMPExecutor : public ExecutorADT
+{
+public:
+	OpenMPExecutor() {};
+	virtual ~OpenMPExecutor() {};
+
+	virtual TaskHandle Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group);
+	virtual ExecutorType GetType() const { return EXECUTOR_OPENMP; };
+};
+
+#endif // !__OPENMPEXECUTOR_H__
@@ -0,0 +1,52 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	ParallelExecutor.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ParallelExecutor
+// Description:
+//		Frame backend running the tiles with std::for_each and the C++17
+//		parallel execution policy. Blocks until the frame is done.
+//
+
+//Self Include
+#include "ParallelExecutor.h"
+
+//Library Includes
+#include <algorithm>
+#include <execution>
+
+//Local Includes
+#include "Task.h"
+
+//	Dispatch( _pJob, _tiles, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Runs every tile with std::execution::par, the standard library
+//		decides how they are split over its threads. Priorities are
+//		ignored. Returns once the frame is done.
+//
+//	Param:
+//		- RenderJob*					|	Image the tiles belong to.
+//		- std::vector<CTask>&			|	Tiles of the frame.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tiles in.
+//
+//	Return: TaskHandle	|	Handle of the group, already complete.
+//
+TaskHandle ParallelExecutor::Dispatch(RenderJob*, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group)
+{
+	_group->Add(static_cast<int>(_tiles.size()));
+	for (size_t i = 0; i < _tiles.size(); i++)
+	{
+		_tiles[i].SetGroup(_group);
+	}
+
+	TaskGroup& group = *_group;
+	std::for_each(std::execution::par, _tiles.begin(), _tiles.end(), [&group](const CTask& _tile)
+	{
+		RunTile(_tile, group);
+	});
+	return TaskHandle(_group);
+}
@@ -0,0 +1,28 @@
+#ifndef __PARALLELEXECUTOR_H__
+#define __PARALLELEXECUTOR_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	ParallelExecutor.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ParallelExecutor
+// Description:
+//		Frame backend running the tiles with std::for_each and the C++17
+//		parallel execution policy. Blocks until the frame is done.
+//
+
+//Local Includes
+#include "ExecutorADT.h"
+
+class ParallelExecutor : public ExecutorADT
+{
+public:
+	ParallelExecutor() {};
+	virtual ~ParallelExecutor() {};
+
+	virtual TaskHandle Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group);
+	virtual ExecutorType GetType() const { return EXECUTOR_PARALLEL_STL; };
+};
+
+#endif // !__PARALLELEXECUTOR_H__
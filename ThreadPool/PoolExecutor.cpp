@@ -0,0 +1,65 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	PoolExecutor.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	PoolExecutor
+// Description:
+//		Frame backend running each tile as a compute node followed by a
+//		colourise node in a TaskGraph on a ThreadPool. Asynchronous, tiles
+//		are queued by their priority and the frame can be cancelled.
+//
+
+//Self Include
+#include "PoolExecutor.h"
+
+//Local Includes
+#include "ThreadPool.h"
+#include "Task.h"
+#include "RenderJob.h"
+
+//	Dispatch( _pJob, _tiles, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Builds the frame's graph and runs it on the pool. Each tile is
+//		computed then colourised on the same worker while it is in cache.
+//		Tiles which colourise themselves, split or progressive ones, are
+//		lone nodes.
+//
+//	Param:
+//		- RenderJob*					|	Image the tiles belong to.
+//		- std::vector<CTask>&			|	Tiles of the frame, with their priorities set.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tiles in.
+//
+//	Return: TaskHandle	|	Handle which completes when every tile is colourised.
+//
+TaskHandle PoolExecutor::Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group)
+{
+	m_graph.Clear();
+	for (size_t i = 0; i < _tiles.size(); i++)
+	{
+		//The tile checks its own group to stop early when cancelled
+		_tiles[i].SetGroup(_group);
+		_tiles[i].SetSplitBudget(m_ulSplitBudget);
+
+		CFunctionTask compute(_tiles[i]);
+		compute.SetPriority(_tiles[i].GetPriority());
+		compute.SetTraceId(_tiles[i].GetStartX(), _tiles[i].GetStartY());
+		if (_tiles[i].ColourisesItself())
+		{
+			m_graph.AddNode(std::move(compute));
+			continue;
+		}
+
+		Range2D tile = _tiles[i].GetRange();
+		CFunctionTask colourise([_pJob, tile]() { _pJob->ColouriseTile(tile); });
+		colourise.SetTraceId(_tiles[i].GetStartX(), _tiles[i].GetStartY());
+
+		unsigned int computeNode = m_graph.AddNode(std::move(compute));
+		unsigned int colouriseNode = m_graph.AddNode(std::move(colourise));
+		m_graph.AddEdge(computeNode, colouriseNode);
+	}
+	return m_pool.Run(m_graph, _group);
+}
@@ -0,0 +1,49 @@
+#ifndef __POOLEXECUTOR_H__
+#define __POOLEXECUTOR_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	PoolExecutor.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	PoolExecutor
+// Description:
+//		Frame backend running each tile as a compute node followed by a
+//		colourise node in a TaskGraph on a ThreadPool. Asynchronous, tiles
+//		are queued by their priority and the frame can be cancelled.
+//
+
+//Local Includes
+#include "ExecutorADT.h"
+#include "TaskGraph.h"
+
+//Forward Declaration
+class ThreadPool;
+
+class PoolExecutor : public ExecutorADT
+{
+public:
+	PoolExecutor(ThreadPool& _pool) : m_pool(_pool) {};
+	virtual ~PoolExecutor() {};
+
+	virtual TaskHandle Dispatch(RenderJob* _pJob, std::vector<CTask>& _tiles, std::shared_ptr<TaskGroup> _group);
+	virtual ExecutorType GetType() const { return EXECUTOR_POOL; };
+	virtual void SetSplitBudget(unsigned long long _iterations) { m_ulSplitBudget = _iterations; };
+
+private:
+	//The PoolExecutor is non-copyable.
+	PoolExecutor(const PoolExecutor& _kr) = delete;
+	PoolExecutor& operator= (const PoolExecutor& _kr) = delete;
+
+	//Member Data:
+private:
+	ThreadPool& m_pool;
+
+	//Rebuilt each frame, the previous frame must be done before the next Dispatch
+	TaskGraph m_graph;
+
+	//Tiles over this many iterations split, 0 keeps the fixed grid
+	unsigned long long m_ulSplitBudget = 0;
+};
+
+#endif // !__POOLEXECUTOR_H__
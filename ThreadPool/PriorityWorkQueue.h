@@ -0,0 +1,161 @@
+#ifndef __PRIORITYWORKQUEUE_H__
+#define __PRIORITYWORKQUEUE_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	PriorityWorkQueue.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CPriorityWorkQueue
+// Description:
+//		Work queue which hands out the item with the lowest GetPriority()
+//		value first. Items with the same priority come out in the order they
+//		were pushed.
+//
+
+//Library Includes
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+
+//Local Includes
+#include "WorkQueueADT.h"
+
+template<typename T>
+class CPriorityWorkQueue : public WorkQueueADT<T>
+{
+public:
+	CPriorityWorkQueue() {}
+
+	//Insert an item into the heap and signal any thread that might be waiting for the q to be populated
+	virtual void push(T&& item)
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		Insert(item);
+		m_WorkQCondition.notify_one();
+	}
+
+	//Insert _count items under one lock, then wake waiting threads once.
+	virtual void push_batch(T* _items, size_t _count)
+	{
+		if (_count == 0)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		for (size_t i = 0; i < _count; i++)
+		{
+			Insert(_items[i]);
+		}
+
+		if (_count == 1)
+		{
+			m_WorkQCondition.notify_one();
+		}
+		else
+		{
+			m_WorkQCondition.notify_all();
+		}
+	}
+
+	//Attempt to get the most important workitem from the queue
+	//If the Q is empty just return false;
+	virtual bool nonblocking_pop(T& _workItem)
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		if (m_heap.empty())
+		{
+			return false;
+		}
+		Take(_workItem);
+		return true;
+	}
+
+	//Take up to _max of the most important items under one lock.
+	virtual size_t pop_batch(T* _workItems, size_t _max)
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		size_t count = 0;
+		while (count < _max && !m_heap.empty())
+		{
+			Take(_workItems[count++]);
+		}
+		return count;
+	}
+
+	//Attempt to get the most important workitem from the queue
+	//If the Q is empty block the thread until a notification is sent to it.
+	virtual bool blocking_pop(T& _workItem, unsigned int time = 0)
+	{
+		std::unique_lock<std::mutex> _lock(m_WorkQMutex);
+		if (time == 0)
+		{
+			m_WorkQCondition.wait(_lock, [this] {return !m_heap.empty(); });
+		}
+		// A retun value of false from wait_for means "timeout has elapsed".
+		else if (!m_WorkQCondition.wait_for(_lock, std::chrono::milliseconds(time), [this] {return !m_heap.empty(); }))
+		{
+			return false;
+		}
+		Take(_workItem);
+		return true;
+	}
+
+	//Checking if the queue is empty or not
+	virtual bool empty() const
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		return m_heap.empty();
+	}
+
+	//Number of items waiting in the queue
+	virtual size_t size() const
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		return m_heap.size();
+	}
+
+private:
+	struct Entry
+	{
+		float m_priority;
+		unsigned long long m_order;
+		T m_item;
+	};
+
+	//Heap comparison, puts the lowest priority value (then the oldest) on top.
+	static bool Later(const Entry& _a, const Entry& _b)
+	{
+		if (_a.m_priority != _b.m_priority)
+		{
+			return _a.m_priority > _b.m_priority;
+		}
+		return _a.m_order > _b.m_order;
+	}
+
+	//Must hold m_WorkQMutex, moves the item into the heap
+	void Insert(T& _item)
+	{
+		Entry entry = { _item.GetPriority(), m_ullNextOrder++, std::move(_item) };
+		m_heap.push_back(std::move(entry));
+		std::push_heap(m_heap.begin(), m_heap.end(), Later);
+	}
+
+	//Must hold m_WorkQMutex, and the heap must not be empty
+	void Take(T& _workItem)
+	{
+		std::pop_heap(m_heap.begin(), m_heap.end(), Later);
+		_workItem = std::move(m_heap.back().m_item);
+		m_heap.pop_back();
+	}
+
+	std::vector<Entry> m_heap;
+	unsigned long long m_ullNextOrder = 0;
+	mutable std::mutex m_WorkQMutex;
+	std::condition_variable m_WorkQCondition;
+};
+
+#endif // !__PRIORITYWORKQUEUE_H__
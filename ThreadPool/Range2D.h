@@ -0,0 +1,97 @@
+#ifndef __RANGE2D_H__
+#define __RANGE2D_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	Range2D.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	Range2D
+// Description:
+//		Half open rectangle of indices [beginX, endX) x [beginY, endY), used
+//		to hand out parts of a screen sized loop to the ThreadPool.
+//
+
+//Library Includes
+#include <vector>
+
+struct Range2D
+{
+	int m_iBeginX;
+	int m_iEndX;
+	int m_iBeginY;
+	int m_iEndY;
+
+	Range2D() : m_iBeginX(0), m_iEndX(0), m_iBeginY(0), m_iEndY(0) {};
+	Range2D(int _beginX, int _endX, int _beginY, int _endY)
+		: m_iBeginX(_beginX), m_iEndX(_endX), m_iBeginY(_beginY), m_iEndY(_endY) {};
+
+	int Width() const { return (m_iEndX > m_iBeginX) ? m_iEndX - m_iBeginX : 0; };
+	int Height() const { return (m_iEndY > m_iBeginY) ? m_iEndY - m_iBeginY : 0; };
+	long long Area() const { return static_cast<long long>(Width()) * Height(); };
+	bool Empty() const { return Area() == 0; };
+
+	//Cells in both ranges, empty if they don't overlap
+	Range2D Intersect(const Range2D& _other) const
+	{
+		return Range2D((m_iBeginX > _other.m_iBeginX) ? m_iBeginX : _other.m_iBeginX, (m_iEndX < _other.m_iEndX) ? m_iEndX : _other.m_iEndX,
+			(m_iBeginY > _other.m_iBeginY) ? m_iBeginY : _other.m_iBeginY, (m_iEndY < _other.m_iEndY) ? m_iEndY : _other.m_iEndY);
+	};
+
+	//Cuts the range in half across its longer side, this keeps the first
+	//half and _other gets the second. Returns false if it is a single cell.
+	bool Split(Range2D& _other)
+	{
+		if (Width() >= Height() && Width() > 1)
+		{
+			int middle = m_iBeginX + Width() / 2;
+			_other = Range2D(middle, m_iEndX, m_iBeginY, m_iEndY);
+			m_iEndX = middle;
+			return true;
+		}
+		if (Height() > 1)
+		{
+			int middle = m_iBeginY + Height() / 2;
+			_other = Range2D(m_iBeginX, m_iEndX, middle, m_iEndY);
+			m_iEndY = middle;
+			return true;
+		}
+		return false;
+	};
+
+	//Splits the range into at most _maxChunks pieces of at least _grain
+	//cells, keeping every piece as close to square as possible.
+	void Divide(long long _grain, unsigned int _maxChunks, std::vector<Range2D>& _chunks) const
+	{
+		_chunks.clear();
+		if (Empty())
+		{
+			return;
+		}
+		_chunks.push_back(*this);
+
+		//Halve the largest piece until we have enough or they are grain sized
+		bool split = true;
+		while (split && _chunks.size() < _maxChunks)
+		{
+			split = false;
+			size_t largest = 0;
+			for (size_t i = 1; i < _chunks.size(); i++)
+			{
+				if (_chunks[i].Area() > _chunks[largest].Area())
+				{
+					largest = i;
+				}
+			}
+
+			Range2D other;
+			if (_chunks[largest].Area() >= 2 * _grain && _chunks[largest].Split(other))
+			{
+				_chunks.push_back(other);
+				split = true;
+			}
+		}
+	};
+};
+
+#endif // !__RANGE2D_H__
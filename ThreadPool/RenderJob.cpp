@@ -0,0 +1,347 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	RenderJob.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	RenderJob
+// Description:
+//		One image of the Mandelbrot set being computed: its resolution,
+//		view of the complex plane, iteration limit, per pixel results and
+//		RGBA output. Tasks point at the job they belong to, so several jobs
+//		can be computed on the same pool at once.
+//
+
+//Self Include
+#include "RenderJob.h"
+
+//Library Includes
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+//Local Includes
+#include "Task.h"
+
+//Constructor
+RenderJob::RenderJob(int _width, int _height, unsigned int _iterationLimit, bool _allocateColumns)
+	: m_iWidth(_width), m_iHeight(_height), m_uiIterationLimit(_iterationLimit)
+{
+	m_pPixels = new Pixel*[m_iWidth]();
+	m_pOutput = new unsigned char[m_iWidth * m_iHeight * 4];
+
+	if (_allocateColumns)
+	{
+		AllocateColumns(0, 1);
+	}
+}
+
+//Destructor
+RenderJob::~RenderJob()
+{
+	for (int i = 0; i < m_iWidth; i++)
+	{
+		delete[] m_pPixels[i];
+	}
+	delete[] m_pPixels;
+	m_pPixels = 0;
+
+	delete[] m_pOutput;
+	m_pOutput = 0;
+}
+
+//	AllocateColumns( _part, _parts )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Allocates one of _parts equal strips of pixel columns. The thread
+//		which calls this is the first to touch the memory. Only needed when
+//		the job was made without allocating its columns.
+//
+//	Param:
+//		- unsigned int	|	Strip to allocate.
+//		- unsigned int	|	Number of strips the image is split into.
+//
+//	Return: n/a		|
+//
+void RenderJob::AllocateColumns(unsigned int _part, unsigned int _parts)
+{
+	int first = static_cast<int>(static_cast<unsigned long long>(m_iWidth) * _part / _parts);
+	int last = static_cast<int>(static_cast<unsigned long long>(m_iWidth) * (_part + 1) / _parts);
+	for (int i = first; i < last; i++)
+	{
+		m_pPixels[i] = new Pixel[m_iHeight];
+	}
+}
+
+//	SetView( _left, _top, _pixelWidth, _pixelHeight )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets the part of the complex plane the next ResetPixels maps onto.
+//		Another job can show the same view at a higher resolution by
+//		dividing the pixel size by the scale.
+//
+//	Param:
+//		- float		|	Real part of the top left pixel.
+//		- float		|	Imaginary part of the top left pixel.
+//		- float		|	Real distance between neighbouring columns.
+//		- float		|	Imaginary distance between neighbouring rows.
+//
+//	Return: n/a		|
+//
+void RenderJob::SetView(float _left, float _top, float _pixelWidth, float _pixelHeight)
+{
+	m_fLeft = _left;
+	m_fTop = _top;
+	m_fPixelWidth = _pixelWidth;
+	m_fPixelHeight = _pixelHeight;
+}
+
+//	FitView( _width, _height, _stepPerPixel, _originX, _originY )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets the view from the zoom and pan the scene works in, mapping the
+//		image onto the Mandelbrot set's part of the complex plane.
+//
+//	Param:
+//		- float		|	Width of the view, in zoomed pixels.
+//		- float		|	Height of the view, in zoomed pixels.
+//		- float		|	Zoomed pixels per image pixel.
+//		- float		|	Horizontal offset of the view, in pixels.
+//		- float		|	Vertical offset of the view, in pixels.
+//
+//	Return: n/a		|
+//
+void RenderJob::FitView(float _width, float _height, float _stepPerPixel, float _originX, float _originY)
+{
+	//Mandlebrot constants
+	const float ReMin = 0.0f;
+	const float ReMax = 4.0f;
+	const float ImMin = -0.0f;
+	const float ImMax = 4.0f;
+
+	//Where the top left pixel lands and how far apart pixels are
+	SetView(
+		(ReMin + ((-_width / 2.0f + _originX) / _width) * (ReMax - ReMin)) * _stepPerPixel,
+		(ImMin + ((_height / 2.0f + _originY) / _height) * (ImMax - ImMin)) * _stepPerPixel,
+		(_stepPerPixel / _width) * (ReMax - ReMin) * _stepPerPixel,
+		(_stepPerPixel / _height) * (ImMax - ImMin) * _stepPerPixel
+	);
+}
+
+//	ResetPixels( _range )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Gives each pixel of _range its complex number for the current view
+//		and clears its result. Ranges don't overlap, so it can be split over
+//		the pool with ParallelFor.
+//
+//	Param:
+//		- Range2D&	|	Pixels to reset.
+//
+//	Return: n/a		|
+//
+void RenderJob::ResetPixels(const Range2D& _range)
+{
+	for (int i = _range.m_iBeginX; i < _range.m_iEndX; i++)
+	{
+		for (int j = _range.m_iBeginY; j < _range.m_iEndY; j++)
+		{
+			//Complex number for this pixel
+			m_pPixels[i][j].c = Complex(m_fLeft + i * m_fPixelWidth, m_fTop - j * m_fPixelHeight);
+
+			//Reset iteration variables
+			m_pPixels[i][j].IsDivergent = false;
+			m_pPixels[i][j].alpha = 0xFF;
+		}
+	}
+}
+
+//	CreateTasks( _divisions, _tasks )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Divides the image into a grid of tasks for this job, column by column.
+//
+//	Param:
+//		- int					|	Number of divisions along each axis.
+//		- std::vector<CTask>&	|	Vector to fill with the tasks.
+//
+//	Return: n/a		|
+//
+void RenderJob::CreateTasks(int _divisions, std::vector<CTask>& _tasks)
+{
+	int sizeX = m_iWidth / _divisions;
+	int sizeY = m_iHeight / _divisions;
+
+	_tasks.reserve(_tasks.size() + (_divisions + 1) * (_divisions + 1));
+
+	for (int i = 0; i < _divisions + 1; i++)
+	{
+		//X coordinate start
+		int startX = i * sizeX;
+
+		for (int j = 0; j < _divisions + 1; j++)
+		{
+			//Y coordinate start
+			int startY = j * sizeY;
+
+			_tasks.push_back(CTask(this, startX, startY, sizeX, sizeY));
+		}
+	}
+}
+
+//	CreateTiles( _tileWidth, _tileHeight, _tasks )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Divides the image into tiles of a fixed size in pixels, column by
+//		column. Tiles cover the image exactly, the last column and row of
+//		tiles are cut short where the image ends.
+//
+//	Param:
+//		- int					|	Width of a tile in pixels.
+//		- int					|	Height of a tile in pixels.
+//		- std::vector<CTask>&	|	Vector to fill with the tasks.
+//
+//	Return: n/a		|
+//
+void RenderJob::CreateTiles(int _tileWidth, int _tileHeight, std::vector<CTask>& _tasks)
+{
+	int columns = (m_iWidth + _tileWidth - 1) / _tileWidth;
+	int rows = (m_iHeight + _tileHeight - 1) / _tileHeight;
+
+	_tasks.reserve(_tasks.size() + columns * rows);
+
+	for (int startX = 0; startX < m_iWidth; startX += _tileWidth)
+	{
+		int sizeX = std::min(_tileWidth, m_iWidth - startX);
+
+		for (int startY = 0; startY < m_iHeight; startY += _tileHeight)
+		{
+			int sizeY = std::min(_tileHeight, m_iHeight - startY);
+
+			_tasks.push_back(CTask(this, startX, startY, sizeX, sizeY));
+		}
+	}
+}
+
+//	GetTileSideForCache( _cacheBytes )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Side of the largest square tile whose pixels and RGBA output fit in
+//		a cache of the given size, rounded down to a multiple of 8.
+//
+//	Param:
+//		- unsigned int	|	Size of the cache in bytes.
+//
+//	Return: int		|	Tile width and height in pixels, at least 8.
+//
+int RenderJob::GetTileSideForCache(unsigned int _cacheBytes)
+{
+	const unsigned int bytesPerPixel = sizeof(Pixel) + 4;
+
+	int side = static_cast<int>(std::sqrt(static_cast<double>(_cacheBytes / bytesPerPixel)));
+	return std::max(8, side - side % 8);
+}
+
+//	ColouriseTile( _tile, _blockSize )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Packs the computed pixels of one tile into the RGBA output. With a
+//		block size, only every _blockSize'th pixel of the image has been
+//		computed and each one fills the block to its right and below. Each
+//		block starts inside exactly one tile, so tiles never write the same
+//		texel even where a block crosses into the next tile.
+//
+//	Param:
+//		- Range2D&		|	Pixels of the tile, clipped to the image.
+//		- unsigned int	|	Width and height of a computed pixel's block.
+//
+//	Return: n/a		|
+//
+void RenderJob::ColouriseTile(const Range2D& _tile, unsigned int _blockSize)
+{
+	if (_blockSize > 1)
+	{
+		const int step = static_cast<int>(_blockSize);
+		for (int i = (_tile.m_iBeginX + step - 1) / step * step; i < _tile.m_iEndX; i += step)
+		{
+			for (int j = (_tile.m_iBeginY + step - 1) / step * step; j < _tile.m_iEndY; j += step)
+			{
+				unsigned char alpha = m_pPixels[i][j].alpha;
+				for (int x = i; x < std::min(i + step, m_iWidth); x++)
+				{
+					for (int y = j; y < std::min(j + step, m_iHeight); y++)
+					{
+						unsigned char* texel = &m_pOutput[(x * m_iHeight + y) * 4];
+						texel[0] = 0xFF;
+						texel[1] = 0xFF;
+						texel[2] = 0xFF;
+						texel[3] = alpha;
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	for (int i = _tile.m_iBeginX; i < _tile.m_iEndX; i++)
+	{
+		for (int j = _tile.m_iBeginY; j < _tile.m_iEndY; j++)
+		{
+			unsigned char* texel = &m_pOutput[(i * m_iHeight + j) * 4];
+			texel[0] = 0xFF;
+			texel[1] = 0xFF;
+			texel[2] = 0xFF;
+			texel[3] = m_pPixels[i][j].alpha;
+		}
+	}
+}
+
+//	SaveImage( _path )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Writes the computed pixels as a greyscale binary PGM, top row first.
+//		Only call once every tile of the job is done.
+//
+//	Param:
+//		- std::string&	|	File to write.
+//
+//	Return: bool	|	False if the file couldn't be written.
+//
+bool RenderJob::SaveImage(const std::string& _path) const
+{
+	std::ofstream file(_path, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	file << "P5\n" << m_iWidth << " " << m_iHeight << "\n255\n";
+
+	//Pixels are stored by column, the file wants rows
+	std::vector<unsigned char> row(m_iWidth);
+	for (int j = 0; j < m_iHeight; j++)
+	{
+		for (int i = 0; i < m_iWidth; i++)
+		{
+			row[i] = m_pPixels[i][j].alpha;
+		}
+		file.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+	return file.good();
+}
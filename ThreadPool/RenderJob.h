@@ -0,0 +1,101 @@
+#ifndef __RENDERJOB_H__
+#define __RENDERJOB_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	RenderJob.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	RenderJob
+// Description:
+//		One image of the Mandelbrot set being computed: its resolution,
+//		view of the complex plane, iteration limit, per pixel results and
+//		RGBA output. Tasks point at the job they belong to, so several jobs
+//		can be computed on the same pool at once.
+//
+
+//Library Includes
+#include <vector>
+#include <string>
+
+//Local Includes
+#include "Complex.h"
+#include "Range2D.h"
+
+//Forward Declaration
+class CTask;
+class CostMap;
+
+struct Pixel
+{
+	Complex c = Complex(0.0f, 0.0f);
+	bool IsDivergent = true;
+	unsigned char alpha = 0xFF;
+};
+
+class RenderJob
+{
+	//Member Functions:
+public:
+	RenderJob(int _width, int _height, unsigned int _iterationLimit, bool _allocateColumns = true);
+	~RenderJob();
+
+	void AllocateColumns(unsigned int _part, unsigned int _parts);
+
+	void SetView(float _left, float _top, float _pixelWidth, float _pixelHeight);
+	void FitView(float _width, float _height, float _stepPerPixel, float _originX, float _originY);
+	void ResetPixels(const Range2D& _range);
+	void CreateTasks(int _divisions, std::vector<CTask>& _tasks);
+	void CreateTiles(int _tileWidth, int _tileHeight, std::vector<CTask>& _tasks);
+	void ColouriseTile(const Range2D& _tile, unsigned int _blockSize = 1);
+	bool SaveImage(const std::string& _path) const;
+
+	float GetLeft() const { return m_fLeft; };
+	float GetTop() const { return m_fTop; };
+	float GetPixelWidth() const { return m_fPixelWidth; };
+	float GetPixelHeight() const { return m_fPixelHeight; };
+
+	void SetIterationLimit(unsigned int _limit) { m_uiIterationLimit = _limit; };
+	unsigned int GetIterationLimit() const { return m_uiIterationLimit; };
+
+	int GetWidth() const { return m_iWidth; };
+	int GetHeight() const { return m_iHeight; };
+	Range2D GetBounds() const { return Range2D(0, m_iWidth, 0, m_iHeight); };
+
+	Pixel& GetPixel(int _x, int _y) { return m_pPixels[_x][_y]; };
+	unsigned char* GetOutput() { return m_pOutput; };
+
+	//Tiles record what they cost into the map, null to not record
+	void SetCostMap(CostMap* _pCostMap) { m_pCostMap = _pCostMap; };
+	CostMap* GetCostMap() const { return m_pCostMap; };
+
+	static int GetTileSideForCache(unsigned int _cacheBytes);
+
+private:
+	//The RenderJob is non-copyable.
+	RenderJob(const RenderJob& _kr) = delete;
+	RenderJob& operator= (const RenderJob& _kr) = delete;
+
+	//Member Data:
+private:
+	int m_iWidth;
+	int m_iHeight;
+	unsigned int m_uiIterationLimit;
+
+	//View of the complex plane, the top left pixel and the size of a pixel
+	float m_fLeft = 0.0f;
+	float m_fTop = 0.0f;
+	float m_fPixelWidth = 1.0f;
+	float m_fPixelHeight = 1.0f;
+
+	//One array per column, m_pPixels[x][y]
+	Pixel** m_pPixels;
+
+	//RGBA written by ColouriseTile, column by column like m_pPixels
+	unsigned char* m_pOutput;
+
+	//Not owned
+	CostMap* m_pCostMap = nullptr;
+};
+
+#endif // !__RENDERJOB_H__
@@ -0,0 +1,266 @@
+#ifndef __RINGWORKQUEUE_H__
+#define __RINGWORKQUEUE_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	RingWorkQueue.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CRingWorkQueue
+// Description:
+//		Fixed capacity, lock-free multi-producer/multi-consumer work queue.
+//		Every cell carries a sequence number which tells producers and
+//		consumers whose turn it is, so push and pop never take a lock or
+//		allocate. The mutex is only used to put idle workers to sleep.
+//
+
+//Library Includes
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+//Local Includes
+#include "WorkQueueADT.h"
+
+template<typename T>
+class CRingWorkQueue : public WorkQueueADT<T>
+{
+public:
+	//Capacity is rounded up to the next power of two.
+	CRingWorkQueue(unsigned int _capacity)
+	{
+		m_uiCapacity = 2;
+		while (m_uiCapacity < _capacity)
+		{
+			m_uiCapacity *= 2;
+		}
+		m_uiMask = m_uiCapacity - 1;
+
+		m_pCells = new Cell[m_uiCapacity];
+		for (unsigned int i = 0; i < m_uiCapacity; i++)
+		{
+			m_pCells[i].m_sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	virtual ~CRingWorkQueue()
+	{
+		delete[] m_pCells;
+		m_pCells = 0;
+	}
+
+	//Insert an item at the back of the queue, yielding while the ring is full.
+	virtual void push(T&& item)
+	{
+		while (!try_push(item))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	//Insert every item, then wake all sleeping workers once.
+	//If the ring fills up part way, workers are woken early to make room.
+	virtual void push_batch(T* _items, size_t _count)
+	{
+		size_t pending = 0;
+		for (size_t i = 0; i < _count; i++)
+		{
+			while (!Enqueue(_items[i]))
+			{
+				Publish(pending);
+				pending = 0;
+				std::this_thread::yield();
+			}
+			pending++;
+		}
+		Publish(pending);
+	}
+
+	//Attempt to move an item into the back of the queue.
+	//If the ring is full just return false and leave the item alone.
+	virtual bool try_push(T& item)
+	{
+		if (!Enqueue(item))
+		{
+			return false;
+		}
+
+		m_aiQueued.fetch_add(1);
+		if (m_aiSleepers > 0)
+		{
+			std::lock_guard<std::mutex> _lock(m_sleepMutex);
+			m_sleepCondition.notify_one();
+		}
+		return true;
+	}
+
+	//Attempt to get a workitem from the queue
+	//If the Q is empty just return false;
+	virtual bool nonblocking_pop(T& _workItem)
+	{
+		size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;)
+		{
+			cell = &m_pCells[pos & m_uiMask];
+			size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+			if (diff == 0)
+			{
+				//Cell holds an item for this position, claim it
+				if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				//Nothing has been written here yet
+				return false;
+			}
+			else
+			{
+				//Another consumer claimed it first
+				pos = m_dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		_workItem = std::move(cell->m_data);
+		cell->m_sequence.store(pos + m_uiMask + 1, std::memory_order_release);
+
+		m_aiQueued.fetch_sub(1);
+		return true;
+	}
+
+	//Attempt to get a workitem from the queue
+	//If the Q is empty block the thread until a notification is sent to it.
+	virtual bool blocking_pop(T& _workItem, unsigned int time = 0)
+	{
+		while (!nonblocking_pop(_workItem))
+		{
+			std::unique_lock<std::mutex> _lock(m_sleepMutex);
+			m_aiSleepers++;
+			bool hasWork = true;
+			if (time == 0)
+			{
+				m_sleepCondition.wait(_lock, [this] {return m_aiQueued > 0; });
+			}
+			else
+			{
+				hasWork = m_sleepCondition.wait_for(_lock, std::chrono::milliseconds(time), [this] {return m_aiQueued > 0; });
+			}
+			m_aiSleepers--;
+
+			// A retun value of false from wait_for means "timeout has elapsed".
+			if (!hasWork)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Checking if the queue is empty or not
+	virtual bool empty() const
+	{
+		return m_aiQueued <= 0;
+	}
+
+	//Number of items in the ring
+	virtual size_t size() const
+	{
+		int queued = m_aiQueued;
+		return (queued > 0) ? static_cast<size_t>(queued) : 0;
+	}
+
+	unsigned int capacity() const
+	{
+		return m_uiCapacity;
+	}
+
+protected:
+	//Count _count newly written items and wake every sleeping worker.
+	void Publish(size_t _count)
+	{
+		if (_count == 0)
+		{
+			return;
+		}
+
+		m_aiQueued.fetch_add(static_cast<int>(_count));
+		if (m_aiSleepers > 0)
+		{
+			std::lock_guard<std::mutex> _lock(m_sleepMutex);
+			m_sleepCondition.notify_all();
+		}
+	}
+
+	//Claim the next free cell and move the item into it.
+	//Returns false if the ring is full, the item is only moved on success.
+	bool Enqueue(T& item)
+	{
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;)
+		{
+			cell = &m_pCells[pos & m_uiMask];
+			size_t seq = cell->m_sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+			if (diff == 0)
+			{
+				//Cell is free for this position, claim it
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				//Cell still holds an item from the previous lap
+				return false;
+			}
+			else
+			{
+				//Another producer claimed it first
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->m_data = std::move(item);
+		cell->m_sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> m_sequence;
+		T m_data;
+	};
+
+	//Producer and consumer positions live on their own cache lines so
+	//producers and consumers don't invalidate each other.
+	char m_padding0[64];
+	std::atomic<size_t> m_enqueuePos{ 0 };
+	char m_padding1[64];
+	std::atomic<size_t> m_dequeuePos{ 0 };
+	char m_padding2[64];
+
+	Cell* m_pCells;
+	unsigned int m_uiCapacity;
+	unsigned int m_uiMask;
+
+	//Number of items in the ring, used to put idle workers to sleep.
+	std::atomic_int m_aiQueued{ 0 };
+	std::atomic_int m_aiSleepers{ 0 };
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+};
+
+#endif // !__RINGWORKQUEUE_H__
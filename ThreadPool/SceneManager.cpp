@@ -7,7 +7,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	SceneManager.h
-// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	SceneManager
 // Description:
 //		Scene Manager that contains static functions to call SceneADT functions. 
@@ -23,6 +23,7 @@
 //Static variables
 float SceneManager::sm_prevTime = 0.0f;
 std::stack<SceneADT*> SceneManager::m_pScenesStack;
+CWorkQueue<std::function<void()>> SceneManager::sm_mainThreadQueue;
 
 //Default Constructor
 SceneManager::SceneManager() 
@@ -131,6 +132,9 @@ void SceneManager::Draw()
 //	Access: public
 //	Description:
 //		Calculates the time since the last call and processes the next frame.
+//		Then runs anything posted to the main thread, sleeping until something
+//		is posted or the next frame is due instead of spinning. Time the scene
+//		spent this tick comes off the sleep, so a tick stays within a frame.
 //		
 //	Param:
 //		
@@ -140,7 +144,8 @@ void SceneManager::Process()
 {
 	glutPostRedisplay();
 
-	float currentTime = (float)glutGet(GLUT_ELAPSED_TIME) * 0.001f;
+	int startMs = glutGet(GLUT_ELAPSED_TIME);
+	float currentTime = (float)startMs * 0.001f;
 	float dt = (currentTime - sm_prevTime);
 	sm_prevTime = currentTime;
 
@@ -148,6 +153,39 @@ void SceneManager::Process()
 		m_pScenesStack.top()->Process(dt);
 
 	//InputHandler::GetInstance().Process(dt);
+
+	//Only sleep out what is left of the frame period, the scene may already
+	//have spent some of it helping the pool
+	int spentMs = glutGet(GLUT_ELAPSED_TIME) - startMs;
+	std::function<void()> posted;
+	bool hasPosted = (spentMs < static_cast<int>(sm_idleSleepMs))
+		? sm_mainThreadQueue.blocking_pop(posted, sm_idleSleepMs - spentMs)
+		: sm_mainThreadQueue.nonblocking_pop(posted);
+	if (hasPosted)
+	{
+		do
+		{
+			posted();
+		} while (sm_mainThreadQueue.nonblocking_pop(posted));
+	}
+}
+
+//	PostToMainThread( _function )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Queues a function to be run on the GLUT main thread during the next
+//		Process call. Safe to call from any thread.
+//		
+//	Param:
+//		- std::function<void()>	|	Function to run.
+//		
+//	Return: n/a		|	
+//
+void SceneManager::PostToMainThread(std::function<void()> _function)
+{
+	sm_mainThreadQueue.push(std::move(_function));
 }
 
 //	OnMouseMove(x, y)
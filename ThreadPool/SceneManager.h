@@ -10,7 +10,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	SceneManager.h
-// Author(s)    |	SceneManager Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	SceneManager Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	SceneManager
 // Description:
 //		Scene Manager that contains static functions to call
@@ -20,9 +20,11 @@
 
 //Local Includes
 #include "SceneADT.h"
+#include "WorkQueue.h"
 
 //Library Include
 #include <stack>
+#include <functional>
 
 class SceneManager
 {
@@ -45,6 +47,9 @@ public:
 	static void OnSpecialReleased(int key, int x, int y);
 	static void OnMouseWheel(int wheel, int dir, int x, int y);
 
+	//Main thread dispatch
+	static void PostToMainThread(std::function<void()> _function);
+
 protected:
 
 private:
@@ -58,6 +63,10 @@ protected:
 	static std::stack<SceneADT*> m_pScenesStack;
 	static float sm_prevTime;
 
+	//Functions posted from other threads, run by Process
+	static CWorkQueue<std::function<void()>> sm_mainThreadQueue;
+	static const unsigned int sm_idleSleepMs = 16;
+
 private:
 
 };
@@ -0,0 +1,96 @@
+#ifndef __SLOTDEQUE_H__
+#define __SLOTDEQUE_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	SlotDeque.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CSlotDeque
+// Description:
+//		Double ended queue stored in one circular array of slots. Slots are
+//		reused as items come and go and the array only ever grows, so once it
+//		has reached its working size pushing and popping never allocate.
+//		Not thread safe, the work queues lock around it.
+//
+
+//Library Includes
+#include <cstddef>
+#include <utility>
+
+template<typename T>
+class CSlotDeque
+{
+public:
+	CSlotDeque(size_t _capacity = 64)
+	{
+		m_capacity = 1;
+		while (m_capacity < _capacity)
+		{
+			m_capacity *= 2;
+		}
+		m_pSlots = new T[m_capacity];
+	}
+
+	~CSlotDeque()
+	{
+		delete[] m_pSlots;
+		m_pSlots = 0;
+	}
+
+	void push_back(T&& _item)
+	{
+		if (m_size == m_capacity)
+		{
+			Grow();
+		}
+		m_pSlots[(m_head + m_size) & (m_capacity - 1)] = std::move(_item);
+		m_size++;
+	}
+
+	//Moves the oldest item into _item.
+	void pop_front(T& _item)
+	{
+		_item = std::move(m_pSlots[m_head]);
+		m_head = (m_head + 1) & (m_capacity - 1);
+		m_size--;
+	}
+
+	//Moves the newest item into _item.
+	void pop_back(T& _item)
+	{
+		m_size--;
+		_item = std::move(m_pSlots[(m_head + m_size) & (m_capacity - 1)]);
+	}
+
+	bool empty() const { return m_size == 0; };
+	size_t size() const { return m_size; };
+	size_t capacity() const { return m_capacity; };
+
+private:
+	//The CSlotDeque is non-copyable.
+	CSlotDeque(const CSlotDeque& _kr) = delete;
+	CSlotDeque& operator= (const CSlotDeque& _kr) = delete;
+
+	//Doubles the array, moving the items to the start of the new one.
+	void Grow()
+	{
+		T* slots = new T[m_capacity * 2];
+		for (size_t i = 0; i < m_size; i++)
+		{
+			slots[i] = std::move(m_pSlots[(m_head + i) & (m_capacity - 1)]);
+		}
+		delete[] m_pSlots;
+
+		m_pSlots = slots;
+		m_capacity *= 2;
+		m_head = 0;
+	}
+
+	T* m_pSlots;
+	size_t m_capacity;
+	size_t m_head = 0;
+	size_t m_size = 0;
+};
+
+#endif // !__SLOTDEQUE_H__
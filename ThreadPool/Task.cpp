@@ -7,7 +7,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	CTask.cpp
-// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	CTask
 // Description:
 //		Task class to calculate the diverging/converging nature of pixels on the screen.
@@ -20,16 +20,13 @@
 //Library Include
 #include <iostream>
 #include <thread>
+#include <chrono>
+#include <glm.hpp>
 
 //Local Include
-#include "SceneManager.h"
-#include "GameScene.h"
 #include "Complex.h"
-#include "iniParser.h"
-#include "Renderer.h"
-
-//Static variables
-unsigned int CTask::LIMIT = 30;
+#include "ThreadPool.h"
+#include "CostMap.h"
 
 //Default Constructor
 CTask::CTask()
@@ -40,8 +37,8 @@ CTask::CTask()
 }
 
 //Main Constructor
-CTask::CTask(int _startXLoc, int _startYLoc, unsigned int _sizeX, unsigned int _sizeY)
-	: m_startX(_startXLoc), m_startY(_startYLoc), m_sizeX(_sizeX), m_sizeY(_sizeY)
+CTask::CTask(RenderJob* _pJob, int _startXLoc, int _startYLoc, unsigned int _sizeX, unsigned int _sizeY)
+	: m_pJob(_pJob), m_startX(_startXLoc), m_startY(_startYLoc), m_sizeX(_sizeX), m_sizeY(_sizeY)
 {
 	
 }
@@ -54,12 +51,19 @@ CTask::~CTask()
 
 //[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //Copy Constructor
-CTask::CTask(const CTask& other)
+CTask::CTask(const CTask& other) noexcept
 {
+	this->m_pJob = other.m_pJob;
 	this->m_startX = other.m_startX;
 	this->m_startY = other.m_startY;
 	this->m_sizeX = other.m_sizeX;
 	this->m_sizeY = other.m_sizeY;
+	this->m_pGroup = other.m_pGroup;
+	this->m_fPriority = other.m_fPriority;
+	this->m_ulSplitBudget = other.m_ulSplitBudget;
+	this->m_uiStride = other.m_uiStride;
+	this->m_bFirstPass = other.m_bFirstPass;
+	this->m_pDoneFlag = other.m_pDoneFlag;
 }
 //[MY WORK] End: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // 
@@ -67,35 +71,110 @@ CTask::CTask(const CTask& other)
 //Equals operator
 CTask& CTask::operator=(const CTask& other)
 {
+	this->m_pJob = other.m_pJob;
 	this->m_startX = other.m_startX;
 	this->m_startY = other.m_startY;
 	this->m_sizeX = other.m_sizeX;
 	this->m_sizeY = other.m_sizeY;
+	this->m_pGroup = other.m_pGroup;
+	this->m_fPriority = other.m_fPriority;
+	this->m_ulSplitBudget = other.m_ulSplitBudget;
+	this->m_uiStride = other.m_uiStride;
+	this->m_bFirstPass = other.m_bFirstPass;
+	this->m_pDoneFlag = other.m_pDoneFlag;
 
 	return *this;
 }
 //[MY WORK] End: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // 
-//Functor
-void CTask::operator()() const
+//Functor, returns the iterations used
+unsigned long long CTask::operator()() const
 {
 	//[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-	//Sleep to simulate work being done
-	GameScene* scene = dynamic_cast<GameScene*>(SceneManager::TopScene());
-	for (unsigned int i = m_startX; i < m_startX + m_sizeX; i++)
+	if (m_pJob == nullptr)
+	{
+		return 0;
+	}
+
+	unsigned int width = static_cast<unsigned int>(m_pJob->GetWidth());
+	unsigned int height = static_cast<unsigned int>(m_pJob->GetHeight());
+	unsigned long long pixels = 0;
+	unsigned long long iterations = 0;
+	unsigned long long sinceSplit = 0;
+	bool cancelled = false;
+
+	//Only read the clock if the job keeps a cost map. Coarse passes only
+	//see some of the tile, the full resolution pass records for them all.
+	CostMap* costMap = (m_uiStride <= 1) ? m_pJob->GetCostMap() : nullptr;
+	std::chrono::steady_clock::time_point start;
+	if (costMap != nullptr)
+	{
+		start = std::chrono::steady_clock::now();
+	}
+
+	//Progressive passes only visit every step'th pixel, from the first on
+	//the image's grid of that step, and skip the ones the last pass did
+	const unsigned int step = (m_uiStride > 0) ? m_uiStride : 1;
+	const unsigned int skip = (m_uiStride > 0 && !m_bFirstPass) ? m_uiStride * 2 : 0;
+	const unsigned int firstX = (m_startX + step - 1) / step * step;
+	const unsigned int firstY = (m_startY + step - 1) / step * step;
+
+	//Shrinks each time the tile gives columns away
+	unsigned int endX = m_startX + m_sizeX;
+	for (unsigned int i = firstX; i < endX; i += step)
 	{
 		//Exceeds pixel limit:
-		if (i >= static_cast<unsigned int>(Renderer::SCREEN_WIDTH))
+		if (i >= width)
 		{
 			break;
 		}
 
-		for (unsigned int j = m_startY; j < m_startY + m_sizeY; j++)
+		//A newer view cancelled this generation, stop at the line boundary
+		if (m_pGroup && m_pGroup->IsCancelled())
+		{
+			m_pGroup->RecordSkipped(CountPixels(i, endX), false);
+			cancelled = true;
+			break;
+		}
+
+		//Over budget, so this tile is in an expensive area. Hand the far half
+		//of the remaining columns to the pool while this worker does the rest.
+		//Progressive tiles don't, a piece could expire after the tile is done.
+		ThreadPool* pool = (m_ulSplitBudget > 0 && m_uiStride == 0 && sinceSplit >= m_ulSplitBudget && endX - i >= 2) ? ThreadPool::GetCurrent() : nullptr;
+		if (pool != nullptr)
+		{
+			unsigned int mid = i + (endX - i) / 2;
+			CTask split(*this);
+			split.m_startX = mid;
+			split.m_sizeX = endX - mid;
+
+			//Wrapped here rather than through Submit, which would take the
+			//priority lock and rerun the priority function for every piece
+			CFunctionTask piece(split);
+			piece.SetPriority(GetPriority());
+			piece.SetTraceId(m_startX, m_startY);
+			piece.SetHelpable(true);
+			pool->SubmitBatch(&piece, 1, m_pGroup);
+
+			endX = mid;
+			sinceSplit = 0;
+		}
+
+		for (unsigned int j = firstY; j < m_startY + m_sizeY; j += step)
 		{
-			if (j < static_cast<unsigned int>(Renderer::SCREEN_HEIGHT))
+			if (j < height)
 			{
-				Pixel* p = &(scene->GetPixel(i, j));
-				p->IsDivergent = Iterate(*p);
+				if (skip > 0 && i % skip == 0 && j % skip == 0)
+				{
+					continue;
+				}
+
+				Pixel* p = &(m_pJob->GetPixel(i, j));
+				unsigned int count = 0;
+				p->IsDivergent = Iterate(*p, count);
+				iterations += count;
+				sinceSplit += count;
+				pixels++;
 			}
 			else
 			{
@@ -104,10 +183,111 @@ void CTask::operator()() const
 			}
 		}
 	}
+
+	Range2D computed = Range2D(m_startX, static_cast<int>(endX), m_startY, m_startY + static_cast<int>(m_sizeY)).Intersect(m_pJob->GetBounds());
+
+	//Split and progressive tiles aren't followed by a colourise node, so colourise what was computed here
+	if (ColourisesItself() && !cancelled)
+	{
+		m_pJob->ColouriseTile(computed, step);
+	}
+
+	//A cancelled tile didn't finish, its cost would look too cheap. The last
+	//progressive pass skips a quarter of the pixels, scale up to the tile.
+	if (costMap != nullptr && !cancelled && pixels > 0)
+	{
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		costMap->Record(computed, iterations * computed.Area() / pixels, elapsed);
+	}
+
+	if (m_pDoneFlag != nullptr && !cancelled)
+	{
+		*m_pDoneFlag = 1;
+	}
+
+	if (m_pGroup)
+	{
+		m_pGroup->RecordWork(pixels, iterations);
+	}
+	ThreadPool::RecordPixels(pixels);
+	return iterations;
 	//[MY WORK] End: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 }
 
-//	Iterate( _pixel )
+//	Discard( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Called instead of running the task when its generation was cancelled
+//		while it was still queued. Records the pixels it would have computed.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void CTask::Discard() const
+{
+	if (m_pGroup && m_pJob)
+	{
+		m_pGroup->RecordSkipped(CountPixels(m_startX, m_startX + m_sizeX), true);
+	}
+}
+
+//	GetRange( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Pixels this task covers, clipped to its job's image. Tiles on the
+//		right and bottom edges hang over the image otherwise.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: Range2D	|	Pixels covered by the task.
+//
+Range2D CTask::GetRange() const
+{
+	Range2D range(m_startX, m_startX + static_cast<int>(m_sizeX), m_startY, m_startY + static_cast<int>(m_sizeY));
+	if (m_pJob != nullptr)
+	{
+		range = range.Intersect(m_pJob->GetBounds());
+	}
+	return range;
+}
+
+//	CountPixels( _fromX, _toX )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Counts the on-screen pixels of this task between two columns.
+//		
+//	Param:
+//		- unsigned int	|	First column to count.
+//		- unsigned int	|	Column after the last one to count.
+//
+//	Return: unsigned int	|	Number of pixels.
+//
+unsigned int CTask::CountPixels(unsigned int _fromX, unsigned int _toX) const
+{
+	int endX = static_cast<int>(_toX);
+	int endY = m_startY + static_cast<int>(m_sizeY);
+	endX = (endX < m_pJob->GetWidth()) ? endX : m_pJob->GetWidth();
+	endY = (endY < m_pJob->GetHeight()) ? endY : m_pJob->GetHeight();
+
+	int width = endX - static_cast<int>(_fromX);
+	int height = endY - m_startY;
+	if (width <= 0 || height <= 0)
+	{
+		return 0;
+	}
+	return static_cast<unsigned int>(width * height);
+}
+
+//	Iterate( _pixel, _iterations )
 //
 //	Author: Michael Jordan
 //	Access: public
@@ -116,16 +296,18 @@ void CTask::operator()() const
 //		
 //	Param:
 //		- GameScene::Pixel&		|	pixel to iterate on.
+//		- unsigned int&			|	Set to the number of iterations used.
 //
 //	Return: bool	|	True if the pixel is divergent.
 //
-bool CTask::Iterate(Pixel& _pixel) const
+bool CTask::Iterate(Pixel& _pixel, unsigned int& _iterations) const
 {
 	//[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 	Complex curr(0.0f, 0.0f);
+	const unsigned int limit = m_pJob->GetIterationLimit();
 
 	//Iterate for n times
-	for (unsigned int i = 0; i < LIMIT; i++)
+	for (unsigned int i = 0; i < limit; i++)
 	{
 		//Create a copy
 		Complex temp(0.0f, 0.0f);
@@ -138,10 +320,12 @@ bool CTask::Iterate(Pixel& _pixel) const
 		if (curr.Moduli() > 2.0f)
 		{
 			//Diverging too far
-			_pixel.alpha = glm::floor(0xFF * i / (float)LIMIT);
+			_pixel.alpha = glm::floor(0xFF * i / (float)limit);
+			_iterations = i + 1;
 			return true;
 		}
 	}
+	_iterations = limit;
 	return false;
 	//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 }
@@ -10,7 +10,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	CTask.h
-// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	CTask
 // Description:
 //		Task class to calculate the diverging/converging nature of pixels on the screen.
@@ -18,33 +18,82 @@
 //
 
 #include <Windows.h>
+#include <memory>
 
-#include "GameScene.h"
+#include "RenderJob.h"
+#include "TaskGroup.h"
 
 class CTask
 {
 public:
 	CTask();
-	CTask(int _startXLoc, int _startYLoc, unsigned int _sizeX, unsigned int _sizeY);
+	CTask(RenderJob* _pJob, int _startXLoc, int _startYLoc, unsigned int _sizeX, unsigned int _sizeY);
 
 	~CTask();
 
-	void operator()() const;
+	unsigned long long operator()() const;
+	void Discard() const;
 
 	std::string ToString();
 
-	CTask(const CTask& other);
+	void SetGroup(const std::shared_ptr<TaskGroup>& _group) { m_pGroup = _group; };
+	TaskGroup* GetGroup() const { return m_pGroup.get(); };
+	unsigned int GetGeneration() const { return m_pGroup ? m_pGroup->GetGeneration() : 0; };
+
+	void SetPriority(float _priority) { m_fPriority = _priority; };
+	float GetPriority() const { return m_fPriority; };
+	int GetStartX() const { return m_startX; };
+	int GetStartY() const { return m_startY; };
+	unsigned int GetSizeX() const { return m_sizeX; };
+	unsigned int GetSizeY() const { return m_sizeY; };
+	RenderJob* GetJob() const { return m_pJob; };
+	Range2D GetRange() const;
+
+	//Iterations a tile may run before it hands half its remaining columns
+	//to another worker, 0 never splits. A tile with a budget colourises
+	//the columns it computed itself.
+	void SetSplitBudget(unsigned long long _iterations) { m_ulSplitBudget = _iterations; };
+	unsigned long long GetSplitBudget() const { return m_ulSplitBudget; };
+
+	//Progressive passes compute every _stride'th pixel in each direction
+	//and colourise it as a block, the first pass starts from nothing and
+	//later ones skip the pixels the pass before did. 0 is a normal tile.
+	void SetPass(unsigned int _stride, bool _firstPass) { m_uiStride = _stride; m_bFirstPass = _firstPass; };
+	unsigned int GetStride() const { return m_uiStride; };
+
+	//Set to 1 once the tile has finished without being cancelled
+	void SetDoneFlag(unsigned char* _pFlag) { m_pDoneFlag = _pFlag; };
+
+	bool ColourisesItself() const { return m_ulSplitBudget > 0 || m_uiStride > 0; };
+	float GetCenterX() const { return m_startX + m_sizeX * 0.5f; };
+	float GetCenterY() const { return m_startY + m_sizeY * 0.5f; };
+
+	CTask(const CTask& other) noexcept;
 	CTask& operator=(const CTask& other);
 
-	static unsigned int LIMIT;
-
 private:
 	
 
-	bool Iterate(Pixel& _pixel) const;
+	bool Iterate(Pixel& _pixel, unsigned int& _iterations) const;
+	unsigned int CountPixels(unsigned int _fromX, unsigned int _toX) const;
+
+	//Image this task computes part of, tasks without one do nothing
+	RenderJob* m_pJob = nullptr;
 
 	int m_startX, m_startY;
 	unsigned int m_sizeX, m_sizeY;
+
+	//Group told when this task has finished, may be empty
+	std::shared_ptr<TaskGroup> m_pGroup;
+
+	//Lower values are taken off a priority queue first
+	float m_fPriority = 0.0f;
+
+	unsigned long long m_ulSplitBudget = 0;
+
+	unsigned int m_uiStride = 0;
+	bool m_bFirstPass = false;
+	unsigned char* m_pDoneFlag = nullptr;
 };
 
 #endif
@@ -0,0 +1,182 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskGraph.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TaskGraph
+// Description:
+//		Tasks with explicit dependencies, run by ThreadPool::Run. A node
+//		starts once every node with an edge into it has finished. The worker
+//		which finishes a node runs its first ready successor straight away,
+//		while the data it just wrote is still in its cache, and queues the
+//		rest. The graph keeps its storage when cleared, so rebuilding the
+//		same shape every frame doesn't allocate.
+//
+
+//Self Include
+#include "TaskGraph.h"
+
+//Default Constructor
+TaskGraph::TaskGraph()
+{
+
+}
+
+//Destructor
+TaskGraph::~TaskGraph()
+{
+
+}
+
+//	AddNode( _task )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds a task to the graph. Its priority and trace id are used when it
+//		is queued.
+//
+//	Param:
+//		- CFunctionTask	|	Task to run, lambdas convert implicitly.
+//
+//	Return: unsigned int	|	Index of the node, used by AddEdge.
+//
+unsigned int TaskGraph::AddNode(CFunctionTask _task)
+{
+	m_tasks.push_back(std::move(_task));
+	return static_cast<unsigned int>(m_tasks.size() - 1);
+}
+
+//	AddEdge( _before, _after )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Makes node _after wait until node _before has finished.
+//
+//	Param:
+//		- unsigned int	|	Node which runs first.
+//		- unsigned int	|	Node which depends on it.
+//
+//	Return: n/a		|
+//
+void TaskGraph::AddEdge(unsigned int _before, unsigned int _after)
+{
+	m_edges.push_back(std::make_pair(_before, _after));
+}
+
+//	Clear( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Removes every node and edge, keeping the storage for the next graph.
+//		Must not be called while the graph is running.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void TaskGraph::Clear()
+{
+	m_tasks.clear();
+	m_edges.clear();
+	m_firstSuccessor.clear();
+	m_successors.clear();
+	m_roots.clear();
+	m_pGroup = nullptr;
+}
+
+//	Prepare( _group )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Builds the successor lists and predecessor counts from the edges and
+//		finds the root nodes. Every node is added to _group. Fails if an edge
+//		names a missing node or the edges form a cycle, which would leave
+//		nodes waiting forever.
+//
+//	Param:
+//		- std::shared_ptr<TaskGroup>&	|	Group to count the nodes in.
+//
+//	Return: bool	|	False if the graph can't be run.
+//
+bool TaskGraph::Prepare(const std::shared_ptr<TaskGroup>& _group)
+{
+	const unsigned int nodeCount = static_cast<unsigned int>(m_tasks.size());
+
+	if (m_pendingCapacity < nodeCount)
+	{
+		m_pPending.reset(new std::atomic_uint[nodeCount]);
+		m_pendingCapacity = nodeCount;
+	}
+
+	//Count the successors and predecessors of each node
+	m_firstSuccessor.assign(nodeCount + 1, 0);
+	m_scratch.assign(nodeCount, 0);
+	for (size_t i = 0; i < m_edges.size(); i++)
+	{
+		if (m_edges[i].first >= nodeCount || m_edges[i].second >= nodeCount)
+		{
+			return false;
+		}
+		m_firstSuccessor[m_edges[i].first + 1]++;
+		m_scratch[m_edges[i].second]++;
+	}
+	for (unsigned int i = 0; i < nodeCount; i++)
+	{
+		m_firstSuccessor[i + 1] += m_firstSuccessor[i];
+		m_pPending[i] = m_scratch[i];
+	}
+
+	//Fill the successor lists, reusing the scratch as a write position per node
+	m_successors.resize(m_edges.size());
+	for (unsigned int i = 0; i < nodeCount; i++)
+	{
+		m_scratch[i] = m_firstSuccessor[i];
+	}
+	for (size_t i = 0; i < m_edges.size(); i++)
+	{
+		m_successors[m_scratch[m_edges[i].first]++] = m_edges[i].second;
+	}
+
+	m_roots.clear();
+	for (unsigned int i = 0; i < nodeCount; i++)
+	{
+		if (m_pPending[i] == 0)
+		{
+			m_roots.push_back(i);
+		}
+	}
+
+	//Walk the graph from the roots, a cycle leaves nodes unreached
+	for (unsigned int i = 0; i < nodeCount; i++)
+	{
+		m_scratch[i] = m_pPending[i];
+	}
+	size_t reached = 0;
+	m_stack.assign(m_roots.begin(), m_roots.end());
+	while (!m_stack.empty())
+	{
+		unsigned int node = m_stack.back();
+		m_stack.pop_back();
+		reached++;
+		for (unsigned int s = m_firstSuccessor[node]; s < m_firstSuccessor[node + 1]; s++)
+		{
+			if (--m_scratch[m_successors[s]] == 0)
+			{
+				m_stack.push_back(m_successors[s]);
+			}
+		}
+	}
+	if (reached != nodeCount)
+	{
+		return false;
+	}
+
+	m_pGroup = _group;
+	m_pGroup->Add(static_cast<int>(nodeCount));
+	return true;
+}
@@ -0,0 +1,77 @@
+#ifndef __TASKGRAPH_H__
+#define __TASKGRAPH_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskGraph.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TaskGraph
+// Description:
+//		Tasks with explicit dependencies, run by ThreadPool::Run. A node
+//		starts once every node with an edge into it has finished. The worker
+//		which finishes a node runs its first ready successor straight away,
+//		while the data it just wrote is still in its cache, and queues the
+//		rest. The graph keeps its storage when cleared, so rebuilding the
+//		same shape every frame doesn't allocate.
+//
+
+//Library Includes
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+//Local Includes
+#include "FunctionTask.h"
+#include "TaskGroup.h"
+
+class TaskGraph
+{
+	friend class ThreadPool;
+
+	//Member Functions:
+public:
+	TaskGraph();
+	~TaskGraph();
+
+	unsigned int AddNode(CFunctionTask _task);
+	void AddEdge(unsigned int _before, unsigned int _after);
+	void Clear();
+
+	size_t GetNodeCount() const { return m_tasks.size(); };
+	size_t GetEdgeCount() const { return m_edges.size(); };
+
+protected:
+	bool Prepare(const std::shared_ptr<TaskGroup>& _group);
+
+private:
+	//The TaskGraph is non-copyable.
+	TaskGraph(const TaskGraph& _kr) = delete;
+	TaskGraph& operator= (const TaskGraph& _kr) = delete;
+
+	//Member Data:
+private:
+	std::vector<CFunctionTask> m_tasks;
+	std::vector<std::pair<unsigned int, unsigned int>> m_edges;
+
+	//Successors of node i are m_successors[m_firstSuccessor[i] .. m_firstSuccessor[i + 1])
+	std::vector<unsigned int> m_firstSuccessor;
+	std::vector<unsigned int> m_successors;
+
+	//Nodes with no predecessors, in the order they were added
+	std::vector<unsigned int> m_roots;
+
+	//Work space for Prepare
+	std::vector<unsigned int> m_scratch;
+	std::vector<unsigned int> m_stack;
+
+	//Predecessors each node is still waiting for while running
+	std::unique_ptr<std::atomic_uint[]> m_pPending;
+	size_t m_pendingCapacity = 0;
+
+	//Counts every node, set by Prepare
+	std::shared_ptr<TaskGroup> m_pGroup;
+};
+
+#endif // !__TASKGRAPH_H__
@@ -0,0 +1,401 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskGroup.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TaskGroup
+// Description:
+//		A latch which counts down as the tasks submitted with it finish.
+//		Threads can wait on it, or register a callback which is run once the
+//		last task is done, optionally on the GLUT main thread. Coroutines
+//		waiting on the group link a Continuation which the last task resumes.
+//		Each group is a render generation which can be cancelled, queued tasks
+//		of a cancelled group are dropped and running ones stop early.
+//
+
+//Self Include
+#include "TaskGroup.h"
+
+//Library Includes
+#include <chrono>
+
+//Local Includes
+#include "SceneManager.h"
+
+//Static Variables
+std::atomic_uint TaskGroup::sm_uiNextGeneration{ 1 };
+
+//Default Constructor
+TaskGroup::TaskGroup()
+{
+	m_uiGeneration = sm_uiNextGeneration++;
+}
+
+//Destructor
+TaskGroup::~TaskGroup()
+{
+
+}
+
+//	Add( _count )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds _count tasks to the group. Must be called before the tasks are submitted.
+//
+//	Param:
+//		- int	|	Number of tasks being added.
+//
+//	Return: n/a		|
+//
+void TaskGroup::Add(int _count)
+{
+	m_aiPending += _count;
+}
+
+//	Done( _count )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Marks _count tasks of the group as finished. The thread which finishes
+//		the last task wakes the waiting threads, resumes the continuations
+//		and fires the callback.
+//
+//	Param:
+//		- int	|	Number of tasks finished.
+//
+//	Return: n/a		|
+//
+void TaskGroup::Done(int _count)
+{
+	if (m_aiPending.fetch_sub(_count) == _count)
+	{
+		Continuation* continuations;
+		{
+			//Lock so a thread between its check and its wait can't miss the notify
+			std::lock_guard<std::mutex> _lock(m_mutex);
+			continuations = m_pContinuations;
+			m_pContinuations = nullptr;
+		}
+		m_condition.notify_all();
+
+		while (continuations != nullptr)
+		{
+			//Resuming may free the continuation, step past it first
+			Continuation* next = continuations->m_pNext;
+			continuations->Resume();
+			continuations = next;
+		}
+
+		FireCallback();
+	}
+}
+
+//	IsComplete( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Checks if every task in the group has finished.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: bool	|	True if no tasks are pending.
+//
+bool TaskGroup::IsComplete() const
+{
+	return m_aiPending <= 0;
+}
+
+//	GetPending( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Returns the number of tasks which haven't finished yet.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: int		|	Tasks pending.
+//
+int TaskGroup::GetPending() const
+{
+	return m_aiPending;
+}
+
+//	Wait( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Blocks the calling thread until every task in the group has finished.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void TaskGroup::Wait()
+{
+	std::unique_lock<std::mutex> _lock(m_mutex);
+	m_condition.wait(_lock, [this] {return m_aiPending <= 0; });
+}
+
+//	WaitFor( _milliseconds )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Blocks the calling thread until every task in the group has finished,
+//		or the time runs out.
+//
+//	Param:
+//		- unsigned int	|	Longest time to wait in milliseconds.
+//
+//	Return: bool	|	True if the group finished in time.
+//
+bool TaskGroup::WaitFor(unsigned int _milliseconds)
+{
+	std::unique_lock<std::mutex> _lock(m_mutex);
+	return m_condition.wait_for(_lock, std::chrono::milliseconds(_milliseconds), [this] {return m_aiPending <= 0; });
+}
+
+//	SetOnComplete( _callback, _onMainThread )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets a function to call once the group finishes. If the group has
+//		already finished it is called straight away.
+//
+//	Param:
+//		- std::function<void()>	|	Function to call.
+//		- bool					|	Post the call to the GLUT main thread instead
+//									of running it on the worker that finished last.
+//
+//	Return: n/a		|
+//
+void TaskGroup::SetOnComplete(std::function<void()> _callback, bool _onMainThread)
+{
+	{
+		std::lock_guard<std::mutex> _lock(m_mutex);
+		m_onComplete = _callback;
+		m_bCallbackOnMainThread = _onMainThread;
+	}
+
+	if (IsComplete())
+	{
+		FireCallback();
+	}
+}
+
+//	AddContinuation( _pContinuation )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Links a continuation which the thread finishing the last task resumes.
+//		Nothing is linked if the group has already finished.
+//
+//	Param:
+//		- Continuation*	|	Continuation to resume, must outlive the group's last Done.
+//
+//	Return: bool	|	False if the group had already finished, the caller
+//						should carry on itself.
+//
+bool TaskGroup::AddContinuation(Continuation* _pContinuation)
+{
+	std::lock_guard<std::mutex> _lock(m_mutex);
+	if (m_aiPending <= 0)
+	{
+		return false;
+	}
+	_pContinuation->m_pNext = m_pContinuations;
+	m_pContinuations = _pContinuation;
+	return true;
+}
+
+//	FireCallback( )
+//
+//	Author: agent
+//	Access: protected
+//	Description:
+//		Runs the callback once, either here or on the main thread.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void TaskGroup::FireCallback()
+{
+	std::function<void()> callback;
+	bool onMainThread;
+	{
+		//Take the callback so it only ever runs once
+		std::lock_guard<std::mutex> _lock(m_mutex);
+		callback.swap(m_onComplete);
+		onMainThread = m_bCallbackOnMainThread;
+	}
+
+	if (!callback)
+	{
+		return;
+	}
+
+	if (onMainThread)
+	{
+		SceneManager::PostToMainThread(callback);
+	}
+	else
+	{
+		callback();
+	}
+}
+
+//	RecordWork( _pixels, _iterations )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds to the pixels and iterations computed by tasks in this group.
+//
+//	Param:
+//		- uint64_t	|	Pixels computed.
+//		- uint64_t	|	Iterations used to compute them.
+//
+//	Return: n/a		|
+//
+void TaskGroup::RecordWork(uint64_t _pixels, uint64_t _iterations)
+{
+	m_aulPixelsComputed += _pixels;
+	m_aulIterations += _iterations;
+}
+
+//	RecordSkipped( _pixels, _wasDropped )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds to the pixels left uncomputed because the group was cancelled.
+//
+//	Param:
+//		- uint64_t	|	Pixels skipped.
+//		- bool		|	True if the whole task was dropped before it ran,
+//						false if it stopped part way through.
+//
+//	Return: n/a		|
+//
+void TaskGroup::RecordSkipped(uint64_t _pixels, bool _wasDropped)
+{
+	m_aulPixelsSkipped += _pixels;
+	if (_wasDropped)
+	{
+		m_aulTasksDropped++;
+	}
+	else
+	{
+		m_aulTasksStopped++;
+	}
+}
+
+//	SetDeadline( _deadline )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets the time the group's tasks should be finished by. Tasks already
+//		running carry on, queued ones are dropped once they can't make it.
+//
+//	Param:
+//		- time_point	|	Steady clock time to finish by.
+//
+//	Return: n/a		|
+//
+void TaskGroup::SetDeadline(std::chrono::steady_clock::time_point _deadline)
+{
+	int64_t deadline = std::chrono::duration_cast<std::chrono::nanoseconds>(_deadline.time_since_epoch()).count();
+	m_alDeadline.store((deadline != 0) ? deadline : 1, std::memory_order_relaxed);
+}
+
+//	ExpireIfLate( _start )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Called by the pool before it starts one of the group's tasks. If the
+//		group's average task so far would end past the deadline the task
+//		should be dropped, this counts it as expired. Until one task has
+//		finished only tasks starting after the deadline expire, so every
+//		group makes some progress.
+//
+//	Param:
+//		- time_point	|	Time the task would start.
+//
+//	Return: bool	|	True if the task should be dropped.
+//
+bool TaskGroup::ExpireIfLate(std::chrono::steady_clock::time_point _start)
+{
+	int64_t deadline = m_alDeadline.load(std::memory_order_relaxed);
+	if (deadline == 0)
+	{
+		return false;
+	}
+
+	uint64_t timed = m_aulTasksTimed.load(std::memory_order_relaxed);
+	int64_t expected = (timed > 0) ? static_cast<int64_t>(m_aulRunNanoseconds.load(std::memory_order_relaxed) / timed) : 0;
+	int64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(_start.time_since_epoch()).count();
+	if (start + expected <= deadline)
+	{
+		return false;
+	}
+	m_aulTasksExpired++;
+	return true;
+}
+
+//	RecordRunTime( _start )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds a task which started at _start and has just finished to the
+//		average ExpireIfLate predicts with.
+//
+//	Param:
+//		- time_point	|	Time the task started.
+//
+//	Return: n/a		|
+//
+void TaskGroup::RecordRunTime(std::chrono::steady_clock::time_point _start)
+{
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+	m_aulRunNanoseconds.fetch_add(static_cast<uint64_t>(elapsed), std::memory_order_relaxed);
+	m_aulTasksTimed.fetch_add(1, std::memory_order_relaxed);
+}
+
+//	EstimateIterationsSaved( _limit )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Estimates the iterations the skipped pixels would have cost, using the
+//		average iterations per pixel of the pixels which were computed.
+//
+//	Param:
+//		- unsigned int	|	Iteration limit, used when nothing was computed.
+//
+//	Return: uint64_t	|	Estimated iterations saved.
+//
+uint64_t TaskGroup::EstimateIterationsSaved(unsigned int _limit) const
+{
+	uint64_t computed = m_aulPixelsComputed;
+	if (computed == 0)
+	{
+		return m_aulPixelsSkipped * _limit;
+	}
+	return static_cast<uint64_t>(m_aulPixelsSkipped * (m_aulIterations / static_cast<double>(computed)));
+}
@@ -0,0 +1,153 @@
+#ifndef __TASKGROUP_H__
+#define __TASKGROUP_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskGroup.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TaskGroup, TaskHandle
+// Description:
+//		A latch which counts down as the tasks submitted with it finish.
+//		Threads can wait on it, or register a callback which is run once the
+//		last task is done, optionally on the GLUT main thread. Coroutines
+//		waiting on the group link a Continuation which the last task resumes.
+//		Each group is a render generation which can be cancelled, queued tasks
+//		of a cancelled group are dropped and running ones stop early.
+//
+
+//Library Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+
+//Enums
+//Service classes, the pool runs interactive work ahead of background work
+enum QoSClass
+{
+	QOS_INTERACTIVE, QOS_BACKGROUND, QOS_COUNT
+};
+
+class TaskGroup
+{
+public:
+	//Resumed by the last Done of the group. Lives in whoever is waiting and
+	//is linked in place, so registering one doesn't allocate.
+	struct Continuation
+	{
+		virtual void Resume() = 0;
+
+		Continuation* m_pNext = nullptr;
+	};
+
+	//Member Functions:
+public:
+	TaskGroup();
+	~TaskGroup();
+
+	void Add(int _count = 1);
+	void Done(int _count = 1);
+
+	bool IsComplete() const;
+	int GetPending() const;
+
+	void Wait();
+	bool WaitFor(unsigned int _milliseconds);
+
+	void SetOnComplete(std::function<void()> _callback, bool _onMainThread = true);
+	bool AddContinuation(Continuation* _pContinuation);
+
+	//Generations
+	unsigned int GetGeneration() const { return m_uiGeneration; };
+	void Cancel() { m_bCancelled = true; };
+	bool IsCancelled() const { return m_bCancelled || (m_pParent && m_pParent->IsCancelled()); };
+
+	//Cancelling the parent cancels this group too, set before submitting
+	void SetParent(std::shared_ptr<TaskGroup> _parent) { m_pParent = _parent; };
+
+	//Class the group's tasks are queued in, set before submitting them
+	void SetQoS(QoSClass _class) { m_eQoS = _class; };
+	QoSClass GetQoS() const { return m_eQoS; };
+
+	//Deadline, set before submitting. Once the group's average task would
+	//finish after it, the pool drops its queued tasks instead of starting them.
+	void SetDeadline(std::chrono::steady_clock::time_point _deadline);
+	bool HasDeadline() const { return m_alDeadline.load(std::memory_order_relaxed) != 0; };
+	bool ExpireIfLate(std::chrono::steady_clock::time_point _start);
+	void RecordRunTime(std::chrono::steady_clock::time_point _start);
+	uint64_t GetTasksExpired() const { return m_aulTasksExpired; };
+
+	//Work accounting, used to report what a cancellation saved
+	void RecordWork(uint64_t _pixels, uint64_t _iterations);
+	void RecordSkipped(uint64_t _pixels, bool _wasDropped);
+	uint64_t GetTasksDropped() const { return m_aulTasksDropped; };
+	uint64_t GetTasksStopped() const { return m_aulTasksStopped; };
+	uint64_t GetPixelsComputed() const { return m_aulPixelsComputed; };
+	uint64_t GetPixelsSkipped() const { return m_aulPixelsSkipped; };
+	uint64_t GetIterations() const { return m_aulIterations; };
+	uint64_t EstimateIterationsSaved(unsigned int _limit) const;
+
+protected:
+	void FireCallback();
+
+private:
+	//The TaskGroup is non-copyable.
+	TaskGroup(const TaskGroup& _kr) = delete;
+	TaskGroup& operator= (const TaskGroup& _kr) = delete;
+
+	//Member Data:
+private:
+	std::atomic_int m_aiPending{ 0 };
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+
+	std::function<void()> m_onComplete;
+	Continuation* m_pContinuations = nullptr;
+	bool m_bCallbackOnMainThread = true;
+
+	unsigned int m_uiGeneration;
+	std::atomic_bool m_bCancelled{ false };
+	std::shared_ptr<TaskGroup> m_pParent;
+	QoSClass m_eQoS = QOS_INTERACTIVE;
+
+	std::atomic<uint64_t> m_aulTasksDropped{ 0 };
+	std::atomic<uint64_t> m_aulTasksStopped{ 0 };
+	std::atomic<uint64_t> m_aulPixelsComputed{ 0 };
+	std::atomic<uint64_t> m_aulPixelsSkipped{ 0 };
+	std::atomic<uint64_t> m_aulIterations{ 0 };
+
+	//Steady clock nanoseconds, 0 for no deadline, and the run time of the
+	//tasks which ran with it
+	std::atomic<int64_t> m_alDeadline{ 0 };
+	std::atomic<uint64_t> m_aulRunNanoseconds{ 0 };
+	std::atomic<uint64_t> m_aulTasksTimed{ 0 };
+	std::atomic<uint64_t> m_aulTasksExpired{ 0 };
+
+	static std::atomic_uint sm_uiNextGeneration;
+};
+
+//Lightweight handle returned by ThreadPool::Submit
+class TaskHandle
+{
+public:
+	TaskHandle() {};
+	TaskHandle(std::shared_ptr<TaskGroup> _group) : m_pGroup(_group) {};
+
+	bool IsValid() const { return m_pGroup != nullptr; };
+	bool IsComplete() const { return !m_pGroup || m_pGroup->IsComplete(); };
+
+	void Wait() { if (m_pGroup) m_pGroup->Wait(); };
+	bool WaitFor(unsigned int _milliseconds) { return !m_pGroup || m_pGroup->WaitFor(_milliseconds); };
+
+	std::shared_ptr<TaskGroup> GetGroup() const { return m_pGroup; };
+
+private:
+	std::shared_ptr<TaskGroup> m_pGroup;
+};
+
+#endif // !__TASKGROUP_H__
@@ -0,0 +1,201 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskTracer.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CTraceRing, TaskTracer
+// Description:
+//		Per worker rings of binary task events, timed with the CPU timestamp
+//		counter. Workers only write into their own preallocated ring, so
+//		recording never locks or allocates. The rings are read on demand and
+//		written out as a Chrome trace_event JSON file (chrome://tracing).
+//
+
+//Self Include
+#include "TaskTracer.h"
+
+//Library Includes
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+//Constructor
+CTraceRing::CTraceRing(size_t _capacity)
+{
+	//Round up to a power of two so the index is a mask
+	size_t capacity = 1;
+	while (capacity < _capacity)
+	{
+		capacity <<= 1;
+	}
+	m_events.resize(capacity);
+	m_mask = capacity - 1;
+}
+
+//Destructor
+CTraceRing::~CTraceRing()
+{
+
+}
+
+//	Collect( _out )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Appends the events recorded since the last call to _out. Safe to call
+//		while the owner is recording. Events the owner overwrote before or
+//		during the copy are left out and counted as lost.
+//
+//	Param:
+//		- std::vector<TraceEvent>&	|	Vector to append the events to.
+//
+//	Return: size_t	|	Number of events lost.
+//
+size_t CTraceRing::Collect(std::vector<TraceEvent>& _out)
+{
+	const uint64_t capacity = m_mask + 1;
+	uint64_t head = m_aulHead.load(std::memory_order_acquire);
+
+	uint64_t lost = 0;
+	if (head - m_ulTail > capacity)
+	{
+		lost = head - capacity - m_ulTail;
+		m_ulTail = head - capacity;
+	}
+
+	size_t first = _out.size();
+	for (uint64_t i = m_ulTail; i < head; i++)
+	{
+		_out.push_back(m_events[i & m_mask]);
+	}
+
+	//Anything the owner has lapped since we read head may be torn, drop it
+	std::atomic_thread_fence(std::memory_order_acquire);
+	uint64_t after = m_aulHead.load(std::memory_order_relaxed);
+	if (after - m_ulTail > capacity)
+	{
+		uint64_t overwritten = after - capacity - m_ulTail;
+		if (overwritten > head - m_ulTail)
+		{
+			overwritten = head - m_ulTail;
+		}
+		_out.erase(_out.begin() + first, _out.begin() + first + static_cast<size_t>(overwritten));
+		lost += overwritten;
+	}
+
+	m_ulTail = head;
+	return static_cast<size_t>(lost);
+}
+
+//Constructor
+TaskTracer::TaskTracer(unsigned int _workers, size_t _capacityPerWorker)
+{
+	if (_workers == 0)
+	{
+		_workers = 1;
+	}
+	for (unsigned int i = 0; i < _workers; i++)
+	{
+		m_rings.push_back(new CTraceRing(_capacityPerWorker));
+	}
+
+	m_ulBaseTicks = ReadTimestamp();
+	m_baseTime = std::chrono::steady_clock::now();
+}
+
+//Destructor
+TaskTracer::~TaskTracer()
+{
+	for (unsigned int i = 0; i < m_rings.size(); i++)
+	{
+		delete m_rings[i];
+	}
+	m_rings.clear();
+}
+
+//	GetTicksPerMicrosecond( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Measures the timestamp rate against the steady clock over the whole
+//		time since construction. Assumes an invariant TSC.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: double	|	Timestamp ticks per microsecond.
+//
+double TaskTracer::GetTicksPerMicrosecond() const
+{
+	uint64_t ticks = ReadTimestamp() - m_ulBaseTicks;
+	double micros = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_baseTime).count()) / 1000.0;
+	return (micros > 0.0 && ticks > 0) ? ticks / micros : 1.0;
+}
+
+//	ExportChromeTrace( _path )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Collects every ring and writes the events recorded since the last
+//		export to a Chrome trace_event JSON file. One row per worker, one
+//		slice per task.
+//
+//	Param:
+//		- std::string	|	Path of the file to write.
+//
+//	Return: bool	|	True if the file was written.
+//
+bool TaskTracer::ExportChromeTrace(const std::string& _path)
+{
+	std::lock_guard<std::mutex> _lock(m_exportMutex);
+
+	for (unsigned int i = 0; i < m_rings.size(); i++)
+	{
+		m_lost += m_rings[i]->Collect(m_collected);
+	}
+
+	double ticksPerMicro = GetTicksPerMicrosecond();
+
+	std::ofstream file(_path);
+	if (!file.is_open())
+	{
+		std::cout << "[TRACE]: Unable to open " << _path << std::endl;
+		return false;
+	}
+
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (unsigned int i = 0; i < m_rings.size(); i++)
+	{
+		file << ((i > 0) ? "," : "") << std::endl;
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\"Worker " << i << "\"}}";
+	}
+
+	for (size_t i = 0; i < m_collected.size(); i++)
+	{
+		const TraceEvent& e = m_collected[i];
+		double start = static_cast<int64_t>(e.m_ulStart - m_ulBaseTicks) / ticksPerMicro;
+		double duration = (e.m_ulEnd - e.m_ulStart) / ticksPerMicro;
+
+		file << "," << std::endl;
+		file << "{\"name\":\"" << (e.m_usDropped ? "Dropped" : "Tile") << " (" << e.m_iTileX << ", " << e.m_iTileY << ")\"";
+		file << ",\"cat\":\"tile\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.m_usWorker;
+		file << ",\"ts\":" << start << ",\"dur\":" << duration;
+		file << ",\"args\":{\"iterations\":" << e.m_ulIterations << ",\"generation\":" << e.m_uiGeneration << "}}";
+	}
+	file << std::endl << "]}" << std::endl;
+
+	std::cout << "[TRACE]: Wrote " << m_collected.size() << " events to " << _path;
+	if (m_lost > 0)
+	{
+		std::cout << " (" << m_lost << " overwritten, raise TraceBufferSize to keep them)";
+	}
+	std::cout << "." << std::endl;
+
+	m_collected.clear();
+	m_lost = 0;
+	return true;
+}
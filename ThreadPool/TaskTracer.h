@@ -0,0 +1,119 @@
+#ifndef __TASKTRACER_H__
+#define __TASKTRACER_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	TaskTracer.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CTraceRing, TaskTracer
+// Description:
+//		Per worker rings of binary task events, timed with the CPU timestamp
+//		counter. Workers only write into their own preallocated ring, so
+//		recording never locks or allocates. The rings are read on demand and
+//		written out as a Chrome trace_event JSON file (chrome://tracing).
+//
+
+//Library Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define TRACE_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACE_HAS_TSC
+#endif
+
+//One finished (or dropped) task
+struct TraceEvent
+{
+	uint64_t m_ulStart;
+	uint64_t m_ulEnd;
+	uint64_t m_ulIterations;
+	int32_t m_iTileX;
+	int32_t m_iTileY;
+	uint32_t m_uiGeneration;
+	uint16_t m_usWorker;
+	uint16_t m_usDropped;
+};
+
+//Single producer ring, only the owning worker may call Record.
+class CTraceRing
+{
+public:
+	CTraceRing(size_t _capacity);
+	~CTraceRing();
+
+	//Overwrites the oldest event once the ring is full.
+	void Record(const TraceEvent& _event)
+	{
+		uint64_t head = m_aulHead.load(std::memory_order_relaxed);
+		m_events[head & m_mask] = _event;
+		m_aulHead.store(head + 1, std::memory_order_release);
+	}
+
+	size_t Collect(std::vector<TraceEvent>& _out);
+
+private:
+	//The CTraceRing is non-copyable.
+	CTraceRing(const CTraceRing& _kr) = delete;
+	CTraceRing& operator= (const CTraceRing& _kr) = delete;
+
+	std::vector<TraceEvent> m_events;
+	size_t m_mask;
+
+	//Written by the owner, on its own cache line so readers don't slow it down
+	alignas(64) std::atomic<uint64_t> m_aulHead{ 0 };
+
+	//First event not collected yet, only touched by Collect
+	alignas(64) uint64_t m_ulTail = 0;
+};
+
+class TaskTracer
+{
+	//Member Functions:
+public:
+	TaskTracer(unsigned int _workers, size_t _capacityPerWorker);
+	~TaskTracer();
+
+	CTraceRing& GetRing(unsigned int _worker) { return *m_rings[_worker % m_rings.size()]; };
+
+	bool ExportChromeTrace(const std::string& _path);
+	double GetTicksPerMicrosecond() const;
+
+	//Raw timestamp, in TSC ticks where available
+	static uint64_t ReadTimestamp()
+	{
+#ifdef TRACE_HAS_TSC
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	};
+
+private:
+	//The TaskTracer is non-copyable.
+	TaskTracer(const TaskTracer& _kr) = delete;
+	TaskTracer& operator= (const TaskTracer& _kr) = delete;
+
+	//Member Data:
+private:
+	std::vector<CTraceRing*> m_rings;
+
+	//Events collected from the rings but not yet written out
+	std::vector<TraceEvent> m_collected;
+	size_t m_lost = 0;
+	std::mutex m_exportMutex;
+
+	//Pair of readings used to turn timestamps into microseconds
+	uint64_t m_ulBaseTicks;
+	std::chrono::steady_clock::time_point m_baseTime;
+};
+
+#endif // !__TASKTRACER_H__
@@ -7,7 +7,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	ThreadPool.h
-// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	ThreadPool
 // Description:
 //		Thread pool to hold tasks and distribute them to working threads.
@@ -15,136 +15,1240 @@
 
 //Library Includes
 #include <iostream>
+#include <algorithm>
 #include <thread>
 #include <functional>
 #include <Chrono>
 
 //Local Includes
 #include "WorkQueue.h"
+#include "WorkStealingQueue.h"
+#include "RingWorkQueue.h"
+#include "PriorityWorkQueue.h"
 #include "Task.h"
-#include "IniParser.h"
 
 //This Include
 #include "ThreadPool.h"
 
 //Static Variables
 ThreadPool* ThreadPool::s_pThreadPool = nullptr;
+thread_local ThreadPool* ThreadPool::tl_pWorkerOf = nullptr;
+thread_local CWorkerCounters* ThreadPool::tl_pCounters = nullptr;
 
-//Default Constructor
-ThreadPool::ThreadPool()
+//Constructor
+ThreadPool::ThreadPool(const ThreadPoolConfig& _config)
+	: m_config(_config)
+{
+	unsigned int hardware = std::thread::hardware_concurrency();
+	hardware = (hardware > 0) ? hardware : 1;
+
+	m_iNumberOfThreads = (_config.m_uiThreadCount > 0) ? _config.m_uiThreadCount : hardware;
+	m_eQueueType = _config.m_eQueueType;
+	m_uiQueueCapacity = _config.m_uiQueueCapacity;
+	m_uiPopBatchSize = _config.m_uiPopBatchSize;
+	m_uiBackgroundEvery = _config.m_uiBackgroundEvery;
+	m_uiTraceCapacity = _config.m_uiTraceCapacity;
+	m_bLogTasks = _config.m_bLogWorkers;
+
+	//Leave room to grow up to the hardware thread count unless told otherwise
+	m_uiMaxWorkers = _config.m_uiMaxThreadCount;
+	if (m_uiMaxWorkers == 0)
+	{
+		m_uiMaxWorkers = (m_iNumberOfThreads > hardware) ? m_iNumberOfThreads.load() : hardware;
+	}
+	else if (m_uiMaxWorkers < m_iNumberOfThreads)
+	{
+		m_uiMaxWorkers = m_iNumberOfThreads;
+	}
+
+	SetMaxQueued(_config.m_uiMaxQueued);
+	SetIdlePolicy(_config.m_uiIdleSpinCount, _config.m_uiIdleYieldCount);
+	SetElasticPolicy(_config.m_uiMinWorkers, _config.m_uiRetireMilliseconds);
+	SetAffinity(_config.m_eAffinity, _config.m_bSkipSMT);
+}
+
+//Destructor
+ThreadPool::~ThreadPool()
+{
+	//[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~
+	{
+		//Under the lock so no worker is started after this
+		std::lock_guard<std::mutex> _lock(m_workersMutex);
+		m_bStop = true;
+	}
+	m_workSignal.NotifyAll();
+	for (unsigned int i = 0; i < m_workerThreads.size(); i++)
+	{
+		if (m_workerThreads[i].joinable())
+		{
+			m_workerThreads[i].join();
+		}
+	}
+	//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
+
+	//Nobody is left to run what is still queued, drop it so waiters are released
+	WorkQueueADT<CFunctionTask>* queues[] = { m_pWorkQueue, m_pBackgroundQueue, m_pOverflowQueue };
+	for (WorkQueueADT<CFunctionTask>* queue : queues)
+	{
+		if (queue == 0)
+		{
+			continue;
+		}
+
+		CFunctionTask workItem;
+		while (queue->nonblocking_pop(workItem))
+		{
+			workItem.Discard();
+			if (workItem.GetGroup() != nullptr)
+			{
+				workItem.GetGroup()->Done();
+			}
+			workItem.Reset();
+		}
+		delete queue;
+	}
+	m_pWorkQueue = 0;
+	m_pBackgroundQueue = 0;
+	m_pOverflowQueue = 0;
+
+	if (m_pTracer != 0)
+	{
+		delete m_pTracer;
+		m_pTracer = 0;
+	}
+
+	if (m_pCounters != 0)
+	{
+		delete[] m_pCounters;
+		m_pCounters = 0;
+	}
+}
+
+//Singleton GetInstance
+ThreadPool& ThreadPool::GetInstance()
+{
+	if (s_pThreadPool == nullptr)
+	{
+		s_pThreadPool = new ThreadPool(ThreadPoolConfig::LoadFromIni());
+	}
+	return (*s_pThreadPool);
+}
+
+//Singleton Destroy Instance
+void ThreadPool::DestroyInstance()
+{
+	if (s_pThreadPool != nullptr)
+	{
+		delete s_pThreadPool;
+	}
+	s_pThreadPool = nullptr;
+}
+
+//	Initialize( )
+//
+//	Author: Provided
+//	Access: public
+//	Description:
+//		Initialise the threadpool variables.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|	
+//
+void ThreadPool::Initialize()
+{
+	//Create a new Work Queue
+	switch (m_eQueueType)
+	{
+	case QUEUE_STEALING:
+		m_pWorkQueue = new CWorkStealingQueue<CFunctionTask>(m_uiMaxWorkers);
+		break;
+
+	case QUEUE_RING:
+		m_pWorkQueue = new CRingWorkQueue<CFunctionTask>(m_uiQueueCapacity);
+		m_pOverflowQueue = new CWorkQueue<CFunctionTask>();
+
+		//Producers should wait for space here rather than inside the ring
+		if (m_uiMaxQueued == 0 || m_uiMaxQueued > m_uiQueueCapacity)
+		{
+			m_uiMaxQueued = m_uiQueueCapacity;
+		}
+		break;
+
+	case QUEUE_PRIORITY:
+		m_pWorkQueue = new CPriorityWorkQueue<CFunctionTask>();
+		break;
+
+	case QUEUE_SHARED:
+	default:
+		m_pWorkQueue = new CWorkQueue<CFunctionTask>();
+		break;
+	}
+
+	//Background work is light on contention, a shared queue is enough. Only
+	//one stealing queue of a type can be bound per thread, so never that.
+	if (m_eQueueType == QUEUE_PRIORITY)
+	{
+		m_pBackgroundQueue = new CPriorityWorkQueue<CFunctionTask>();
+	}
+	else
+	{
+		m_pBackgroundQueue = new CWorkQueue<CFunctionTask>();
+	}
+
+	//Preallocate every worker's trace ring up front
+	if (m_uiTraceCapacity > 0)
+	{
+		m_pTracer = new TaskTracer(m_uiMaxWorkers, m_uiTraceCapacity);
+	}
+
+	//Decide which processors each worker runs on
+	m_placements = CpuAffinity::PlanWorkers(m_uiMaxWorkers, m_eAffinity, m_bSkipSMT);
+
+	//One cache line of stats per worker slot
+	m_pCounters = new CWorkerCounters[m_uiMaxWorkers];
+	m_ulClockBaseTicks = TaskTracer::ReadTimestamp();
+	m_clockBaseTime = std::chrono::steady_clock::now();
+	ResetStats();
+}
+
+//	Start( )
+//
+//	Author: Provided
+//	Access: public
+//	Description:
+//		Add N threads to the vector of threads. Each thread is given the index
+//		of the worker slot it owns. Returns once every worker has pinned
+//		itself and run the worker start up function.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|	
+//
+void ThreadPool::Start()
+{
+	m_workerThreads.resize(m_uiMaxWorkers);
+	m_workerLive.assign(m_uiMaxWorkers, false);
+
+	m_pStartupGroup = std::make_shared<TaskGroup>();
+	m_pStartupGroup->Add(static_cast<int>(m_iNumberOfThreads));
+	SpawnWorkers();
+
+	//Workers are pinned and have run their start up function from here on
+	m_pStartupGroup->Wait();
+	{
+		std::lock_guard<std::mutex> _lock(m_workersMutex);
+		m_pStartupGroup = nullptr;
+	}
+}
+
+//	Resize( _count )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Changes how many workers the pool runs. New workers start straight
+//		away, surplus workers finish the tasks they hold and leave. Queued
+//		tasks are not affected. Clamped to between 1 and GetMaxWorkerCount.
+//		
+//	Param:
+//		- unsigned int	|	Workers wanted.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::Resize(unsigned int _count)
+{
+	_count = (_count < 1) ? 1 : ((_count > m_uiMaxWorkers) ? m_uiMaxWorkers : _count);
+	m_iNumberOfThreads = _count;
+
+	if (m_workerThreads.empty())
+	{
+		//Not started yet, Start uses the new count
+		return;
+	}
+
+	//Surplus workers notice the new count when they wake
+	m_workSignal.NotifyAll();
+	SpawnWorkers();
+}
+
+//	SetElasticPolicy( _minWorkers, _retireMilliseconds )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Lets idle workers give their cores back. A worker which has been
+//		parked for _retireMilliseconds leaves the pool, except for the first
+//		_minWorkers. They are started again once more tasks are queued than
+//		there are workers running.
+//		
+//	Param:
+//		- unsigned int	|	Workers which never leave, at least 1.
+//		- unsigned int	|	Time parked before leaving, 0 to turn this off.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::SetElasticPolicy(unsigned int _minWorkers, unsigned int _retireMilliseconds)
+{
+	m_uiMinWorkers = (_minWorkers < 1) ? 1 : _minWorkers;
+	m_uiRetireMilliseconds = _retireMilliseconds;
+}
+
+//	SpawnWorkers( )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Starts a thread for every worker slot below the wanted count which
+//		has none running, joining the thread which last left the slot.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|	
+//
+void ThreadPool::SpawnWorkers()
+{
+	std::lock_guard<std::mutex> _lock(m_workersMutex);
+	if (m_bStop)
+	{
+		return;
+	}
+
+	unsigned int wanted = m_iNumberOfThreads;
+	for (unsigned int i = 0; i < wanted && i < m_workerThreads.size(); i++)
+	{
+		if (m_workerLive[i])
+		{
+			continue;
+		}
+
+		//The last thread of this slot marked itself gone under the lock, so it is only returning
+		if (m_workerThreads[i].joinable())
+		{
+			m_workerThreads[i].join();
+		}
+
+		m_workerLive[i] = true;
+		m_uiLiveWorkers++;
+		m_workerThreads[i] = std::thread(&ThreadPool::DoWork, this, i, m_pStartupGroup);
+	}
+}
+
+//	Submit( _fItem, _group )
+//
+//	Author: Provided
+//	Access: public
+//	Description:
+//		Adds a tile task to the back of the work queue, giving it a priority
+//		if a priority function is set.
+//		
+//	Param:
+//		- CTask						|	Task to add to the list of tasks.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the task in. A new group
+//										is made for the task if none is given.
+//
+//	Return: TaskHandle	|	Handle which completes when the task has finished.
+//
+TaskHandle ThreadPool::Submit(CTask _fItem, std::shared_ptr<TaskGroup> _group)
+{
+	return SubmitBatch(&_fItem, 1, _group);
+}
+
+//	SubmitBatch( _pItems, _count, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds a contiguous range of tile tasks to the back of the work queue in
+//		one go, so the queue is locked and sleeping workers are woken once.
+//		The range is reordered by priority if a priority function is set.
+//		
+//	Param:
+//		- CTask*						|	First task of the range.
+//		- size_t						|	Number of tasks in the range.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tasks in. A new group
+//										is made for the range if none is given.
+//
+//	Return: TaskHandle	|	Handle which completes when every task has finished.
+//
+TaskHandle ThreadPool::SubmitBatch(CTask* _pItems, size_t _count, std::shared_ptr<TaskGroup> _group)
+{
+	if (!_group)
+	{
+		_group = std::make_shared<TaskGroup>();
+	}
+
+	{
+		std::lock_guard<std::mutex> _lock(m_priorityMutex);
+		if (m_priorityFunction)
+		{
+			for (size_t i = 0; i < _count; i++)
+			{
+				_pItems[i].SetPriority(m_priorityFunction(_pItems[i]));
+			}
+
+			//FIFO queues hand the range out in order, so order it here instead
+			if (m_eQueueType != QUEUE_PRIORITY)
+			{
+				std::stable_sort(_pItems, _pItems + _count, [](const CTask& _a, const CTask& _b) { return _a.GetPriority() < _b.GetPriority(); });
+			}
+		}
+	}
+
+	//Wrap the tiles, reusing this thread's scratch space so nothing is allocated
+	static thread_local std::vector<CFunctionTask> s_scratch;
+	s_scratch.resize(_count);
+	for (size_t i = 0; i < _count; i++)
+	{
+		//The tile checks its own group to stop early when cancelled
+		_pItems[i].SetGroup(_group);
+
+		s_scratch[i] = CFunctionTask(_pItems[i]);
+		s_scratch[i].SetPriority(_pItems[i].GetPriority());
+		s_scratch[i].SetTraceId(_pItems[i].GetStartX(), _pItems[i].GetStartY());
+		s_scratch[i].SetHelpable(true);
+	}
+
+	TaskHandle handle = SubmitBatch(s_scratch.data(), _count, _group);
+	s_scratch.clear();
+	return handle;
+}
+
+//	Submit( _task, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds any callable to the back of the work queue. Lambdas convert to a
+//		CFunctionTask implicitly.
+//		
+//	Param:
+//		- CFunctionTask				|	Task to run.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the task in. A new group
+//										is made for the task if none is given.
+//
+//	Return: TaskHandle	|	Handle which completes when the task has finished.
+//
+TaskHandle ThreadPool::Submit(CFunctionTask _task, std::shared_ptr<TaskGroup> _group)
+{
+	return SubmitBatch(&_task, 1, _group);
+}
+
+//	SubmitBatch( _pTasks, _count, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Moves a contiguous range of tasks into the work queue in one go. The
+//		tasks are queued in their group's class and the range is left empty.
+//		
+//	Param:
+//		- CFunctionTask*				|	First task of the range.
+//		- size_t						|	Number of tasks in the range.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the tasks in. A new group
+//										is made for the range if none is given.
+//
+//	Return: TaskHandle	|	Handle which completes when every task has finished.
+//
+TaskHandle ThreadPool::SubmitBatch(CFunctionTask* _pTasks, size_t _count, std::shared_ptr<TaskGroup> _group)
+{
+	if (!_group)
+	{
+		_group = std::make_shared<TaskGroup>();
+	}
+	if (_count == 0)
+	{
+		return TaskHandle(_group);
+	}
+
+	_group->Add(static_cast<int>(_count));
+	for (size_t i = 0; i < _count; i++)
+	{
+		_pTasks[i].SetGroup(_group);
+		_pTasks[i].SetQoS(_group->GetQoS());
+	}
+
+	Enqueue(_pTasks, _count);
+
+	return TaskHandle(_group);
+}
+
+//	Post( _task )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Moves a task into the work queue without a group, so nothing can wait
+//		on it and nothing is allocated. Used to resume coroutines. The task
+//		is queued in its own class.
+//		
+//	Param:
+//		- CFunctionTask	|	Task to run.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::Post(CFunctionTask _task)
+{
+	Enqueue(&_task, 1);
+}
+
+//	TrySubmit( _task, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Queues the task only if there is room for it right now.
+//		
+//	Param:
+//		- CFunctionTask&				|	Task to run, moved from only if it was queued.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the task in. A new group
+//										is made for the task if none is given.
+//
+//	Return: TaskHandle	|	Handle for the task, invalid if the queue was full.
+//
+TaskHandle ThreadPool::TrySubmit(CFunctionTask& _task, std::shared_ptr<TaskGroup> _group)
+{
+	return SubmitFor(_task, 0, _group);
+}
+
+//	SubmitFor( _task, _milliseconds, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Queues the task, waiting up to _milliseconds for workers to make room.
+//		
+//	Param:
+//		- CFunctionTask&				|	Task to run, moved from only if it was queued.
+//		- unsigned int					|	Longest time to wait for room.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the task in. A new group
+//										is made for the task if none is given.
+//
+//	Return: TaskHandle	|	Handle for the task, invalid if it timed out.
+//
+TaskHandle ThreadPool::SubmitFor(CFunctionTask& _task, unsigned int _milliseconds, std::shared_ptr<TaskGroup> _group)
+{
+	if (!_group)
+	{
+		_group = std::make_shared<TaskGroup>();
+	}
+	if (!ReserveQueue(1, _milliseconds, _group->GetQoS()))
+	{
+		return TaskHandle();
+	}
+
+	_group->Add();
+	_task.SetGroup(_group);
+	_task.SetQoS(_group->GetQoS());
+
+	PushReserved(&_task, 1);
+	return TaskHandle(_group);
+}
+
+//	Run( _graph, _group )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Runs a task graph. The root nodes are queued in priority order, every
+//		other node is started by the worker which finishes its last
+//		predecessor. The graph must not be changed or destroyed until the
+//		handle completes. Cancelling the group discards the nodes which
+//		haven't started.
+//		
+//	Param:
+//		- TaskGraph&					|	Graph to run.
+//		- std::shared_ptr<TaskGroup>	|	Group to count the nodes in. A new group
+//										is made for the graph if none is given.
+//
+//	Return: TaskHandle	|	Handle which completes when every node has finished.
+//
+TaskHandle ThreadPool::Run(TaskGraph& _graph, std::shared_ptr<TaskGroup> _group)
+{
+	if (!_group)
+	{
+		_group = std::make_shared<TaskGroup>();
+	}
+
+	if (!_graph.Prepare(_group))
+	{
+		std::cout << "[THREADPOOL]: Task graph not run, an edge names a missing node or the edges form a cycle." << std::endl;
+		return TaskHandle(_group);
+	}
+
+	//Reuse this thread's scratch space so nothing is allocated once warmed up
+	static thread_local std::vector<size_t> s_order;
+	static thread_local std::vector<CFunctionTask> s_scratch;
+	const size_t roots = _graph.m_roots.size();
+	s_order.resize(roots);
+	for (size_t i = 0; i < roots; i++)
+	{
+		s_order[i] = i;
+	}
+
+	//FIFO queues hand the roots out in order, so order them here instead.
+	//std::sort sorts in place, the index keeps equal priorities in order.
+	if (m_eQueueType != QUEUE_PRIORITY)
+	{
+		std::sort(s_order.begin(), s_order.end(), [&_graph](size_t _a, size_t _b)
+		{
+			float a = _graph.m_tasks[_graph.m_roots[_a]].GetPriority();
+			float b = _graph.m_tasks[_graph.m_roots[_b]].GetPriority();
+			return (a < b) || (a == b && _a < _b);
+		});
+	}
+
+	s_scratch.resize(roots);
+	for (size_t i = 0; i < roots; i++)
+	{
+		s_scratch[i] = MakeNodeTask(&_graph, _graph.m_roots[s_order[i]]);
+	}
+
+	Enqueue(s_scratch.data(), s_scratch.size());
+	s_scratch.clear();
+
+	return TaskHandle(_group);
+}
+
+//	Enqueue( _pTasks, _count )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Moves tasks into their class's queue and wakes workers for them. The
+//		range goes in as runs of one class. When the queue is bounded a large
+//		run goes in a queue's worth at a time, waiting for the workers to
+//		make room between each.
+//		
+//	Param:
+//		- CFunctionTask*	|	First task of the range.
+//		- size_t			|	Number of tasks in the range.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::Enqueue(CFunctionTask* _pTasks, size_t _count)
+{
+	size_t chunk = (m_uiMaxQueued > 0) ? m_uiMaxQueued : _count;
+	size_t first = 0;
+	while (first < _count)
+	{
+		QoSClass qos = _pTasks[first].GetQoS();
+		size_t count = 1;
+		while (first + count < _count && count < chunk && _pTasks[first + count].GetQoS() == qos)
+		{
+			count++;
+		}
+
+		ReserveQueue(static_cast<int>(count), WAIT_FOREVER, qos);
+		PushReserved(_pTasks + first, count);
+		first += count;
+	}
+}
+
+//	ReserveQueue( _count, _milliseconds, _class )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Counts _count tasks into the queue depth, waiting for room if the
+//		class's queue is bounded and full. Each class has its own bound, so
+//		interactive submits never wait behind background work. Workers are
+//		never made to wait, they are the ones making room. A range larger
+//		than the whole bound is let in once the class's queue is empty.
+//		
+//	Param:
+//		- int			|	Tasks about to be pushed.
+//		- unsigned int	|	Longest time to wait in milliseconds, 0 to not
+//							wait and WAIT_FOREVER to wait until there is room.
+//		- QoSClass		|	Class of the tasks.
+//
+//	Return: bool	|	False if there was no room in time, nothing is counted.
+//
+bool ThreadPool::ReserveQueue(int _count, unsigned int _milliseconds, QoSClass _class)
+{
+	if (m_uiMaxQueued == 0 || tl_pWorkerOf == this)
+	{
+		m_aiQueuedByClass[_class] += _count;
+	}
+	else if (!TryReserveQueue(_count, _class))
+	{
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_milliseconds);
+		if (_milliseconds == 0)
+		{
+			return false;
+		}
+		m_aulBlockedSubmits++;
+
+		do
+		{
+			unsigned int key = m_spaceSignal.PrepareWait();
+			int queued = m_aiQueuedByClass[_class];
+			if (queued == 0 || queued + _count <= static_cast<int>(m_uiMaxQueued))
+			{
+				m_spaceSignal.CancelWait();
+				continue;
+			}
+
+			if (_milliseconds == WAIT_FOREVER)
+			{
+				m_spaceSignal.Wait(key);
+				continue;
+			}
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+			{
+				m_spaceSignal.CancelWait();
+				return false;
+			}
+			m_spaceSignal.WaitFor(key, static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1);
+		} while (!TryReserveQueue(_count, _class));
+	}
+
+	//The total is what idle workers watch, so it goes up before the push
+	int depth = (m_aiQueued += _count);
+	int highWater = m_aiQueueHighWater;
+	while (depth > highWater && !m_aiQueueHighWater.compare_exchange_weak(highWater, depth));
+	return true;
+}
+
+//	TryReserveQueue( _count, _class )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Counts _count tasks into their class's depth if they fit under the
+//		bound. The caller adds them to the total.
+//		
+//	Param:
+//		- int		|	Tasks about to be pushed.
+//		- QoSClass	|	Class of the tasks.
+//
+//	Return: bool	|	True if they were counted.
+//
+bool ThreadPool::TryReserveQueue(int _count, QoSClass _class)
+{
+	std::atomic_int& depth = m_aiQueuedByClass[_class];
+	int queued = depth;
+	do
+	{
+		if (queued > 0 && queued + _count > static_cast<int>(m_uiMaxQueued))
+		{
+			return false;
+		}
+	} while (!depth.compare_exchange_weak(queued, queued + _count));
+	return true;
+}
+
+//	PushReserved( _pTasks, _count )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Pushes tasks already counted by ReserveQueue, then wakes a parked
+//		worker per task. The count comes first so idle workers can't park
+//		past the tasks, the wake comes last so they don't wake to nothing.
+//		Workers spill what doesn't fit in the ring into the overflow queue.
+//		
+//	Param:
+//		- CFunctionTask*	|	First task of the range.
+//		- size_t			|	Number of tasks in the range.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::PushReserved(CFunctionTask* _pTasks, size_t _count)
+{
+	if (_count == 0)
+	{
+		return;
+	}
+
+	//One timestamp for the whole batch, workers measure the queue wait from it
+	uint64_t now = TaskTracer::ReadTimestamp();
+	for (size_t i = 0; i < _count; i++)
+	{
+		_pTasks[i].SetQueuedAt(now);
+	}
+
+	//A run from Enqueue is all one class
+	if (_pTasks[0].GetQoS() == QOS_BACKGROUND)
+	{
+		m_pBackgroundQueue->push_batch(_pTasks, _count);
+	}
+	else if (m_pOverflowQueue != nullptr && tl_pWorkerOf == this)
+	{
+		//A worker waiting for room in the ring could be waiting on itself,
+		//what doesn't fit goes to the overflow queue instead
+		size_t pushed = 0;
+		while (pushed < _count && m_pWorkQueue->try_push(_pTasks[pushed]))
+		{
+			pushed++;
+		}
+		if (pushed < _count)
+		{
+			m_pOverflowQueue->push_batch(_pTasks + pushed, _count - pushed);
+			m_aiOverflowed += static_cast<int>(_count - pushed);
+		}
+	}
+	else
+	{
+		m_pWorkQueue->push_batch(_pTasks, _count);
+	}
+	m_TotalItems += static_cast<int>(_count);
+
+	//Woken workers find the tasks already there, one per task is enough
+	m_workSignal.Notify(static_cast<unsigned int>(_count));
+
+	//Start retired workers again once there is more queued than running
+	if (m_uiLiveWorkers < m_iNumberOfThreads && m_aiQueued > static_cast<int>(m_uiLiveWorkers))
+	{
+		SpawnWorkers();
+	}
+}
+
+//	MakeNodeTask( _pGraph, _node )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Wraps a graph node for the work queue, copying its priority and trace
+//		id. Nodes are queued in the class of the graph's group.
+//		
+//	Param:
+//		- TaskGraph*	|	Running graph.
+//		- unsigned int	|	Node to wrap.
+//
+//	Return: CFunctionTask	|	Task which runs the node.
+//
+CFunctionTask ThreadPool::MakeNodeTask(TaskGraph* _pGraph, unsigned int _node)
+{
+	const CFunctionTask& node = _pGraph->m_tasks[_node];
+
+	CFunctionTask task(GraphNodeTask{ this, _pGraph, _node });
+	task.SetPriority(node.GetPriority());
+	task.SetTraceId(node.GetTraceX(), node.GetTraceY());
+	task.SetQoS(_pGraph->m_pGroup->GetQoS());
+	task.SetHelpable(true);
+	return task;
+}
+
+//	RunNode( _pGraph, _node, _discard )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Runs a graph node, then releases its successors. The first successor
+//		that becomes ready runs next on this thread, while the node's output
+//		is still in cache, the others are queued for any worker.
+//		
+//	Param:
+//		- TaskGraph*	|	Running graph.
+//		- unsigned int	|	Node whose predecessors have all finished.
+//		- bool			|	Discard the nodes instead of running them.
+//
+//	Return: unsigned long long	|	Iterations reported by the nodes run.
+//
+unsigned long long ThreadPool::RunNode(TaskGraph* _pGraph, unsigned int _node, bool _discard)
+{
+	static const unsigned int NO_NODE = 0xFFFFFFFF;
+
+	//Hold the group, the graph's owner may drop it once the last node is done
+	std::shared_ptr<TaskGroup> group = _pGraph->m_pGroup;
+	unsigned long long iterations = 0;
+
+	while (_node != NO_NODE)
+	{
+		//A node which would run past the deadline is dropped with the rest
+		//of its chain, successors queued elsewhere check the deadline again
+		CFunctionTask& task = _pGraph->m_tasks[_node];
+		bool timed = !_discard && group->HasDeadline();
+		std::chrono::steady_clock::time_point started = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+		_discard = _discard || (timed && group->ExpireIfLate(started));
+		if (_discard || group->IsCancelled())
+		{
+			task.Discard();
+		}
+		else
+		{
+			iterations += task();
+			if (timed)
+			{
+				group->RecordRunTime(started);
+			}
+		}
+		task.Reset();
+
+		unsigned int next = NO_NODE;
+		for (unsigned int s = _pGraph->m_firstSuccessor[_node]; s < _pGraph->m_firstSuccessor[_node + 1]; s++)
+		{
+			unsigned int successor = _pGraph->m_successors[s];
+			if (_pGraph->m_pPending[successor].fetch_sub(1) != 1)
+			{
+				continue;
+			}
+
+			if (next == NO_NODE)
+			{
+				next = successor;
+			}
+			else
+			{
+				Post(MakeNodeTask(_pGraph, successor));
+			}
+		}
+
+		//Done last, nothing touches the graph after its final node is done
+		group->Done();
+		_node = next;
+	}
+	return iterations;
+}
+
+//	RunParallel( _range, _grain, _pBody, _invoke )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Shared part of ParallelFor and ParallelReduce. Divides the range into
+//		chunks, submits a helper task per worker which claims chunks until
+//		none are left, and claims chunks on the calling thread too. Returns
+//		when every chunk has been run. Safe to call from a worker, the caller
+//		finishes the chunks itself if no helper gets to run.
+//		
+//	Param:
+//		- Range2D&		|	Cells to cover.
+//		- unsigned int	|	Fewest cells worth giving to one chunk.
+//		- void*			|	Body to call on each chunk.
+//		- void(*)(...)	|	Calls the body with a chunk and participant index.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::RunParallel(const Range2D& _range, unsigned int _grain, void* _pBody, void(*_invoke)(void*, const Range2D&, unsigned int))
+{
+	//Enough chunks for a few each so uneven chunks balance out
+	std::shared_ptr<ParallelState> state = std::make_shared<ParallelState>();
+	_range.Divide((_grain > 0) ? _grain : 1, (m_iNumberOfThreads + 1) * 4, state->m_chunks);
+	if (state->m_chunks.empty())
+	{
+		return;
+	}
+
+	state->m_pBody = _pBody;
+	state->m_invoke = _invoke;
+	state->m_chunksDone.Add(static_cast<int>(state->m_chunks.size()));
+
+	//No point waking more helpers than there are chunks left for them
+	size_t helpers = state->m_chunks.size() - 1;
+	unsigned int workers = m_iNumberOfThreads;
+	if (helpers > workers)
+	{
+		helpers = workers;
+	}
+
+	if (helpers > 0)
+	{
+		std::vector<CFunctionTask> tasks(helpers);
+		for (unsigned int i = 0; i < helpers; i++)
+		{
+			tasks[i] = CFunctionTask([state, i]() { state->Run(i); });
+		}
+		SubmitBatch(tasks.data(), tasks.size());
+	}
+
+	//The calling thread is the last participant
+	state->Run(m_uiMaxWorkers);
+	state->m_chunksDone.Wait();
+}
+
+//	Run( _participant )
+//
+//	Author: agent
+//	Access: private
+//	Description:
+//		Claims and runs chunks until there are none left.
+//		
+//	Param:
+//		- unsigned int	|	Index of the calling participant.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::ParallelState::Run(unsigned int _participant)
+{
+	for (;;)
+	{
+		unsigned int chunk = m_uiNextChunk++;
+		if (chunk >= m_chunks.size())
+		{
+			return;
+		}
+		m_invoke(m_pBody, m_chunks[chunk], _participant);
+		m_chunksDone.Done();
+	}
+}
+
+//	SetPriorityFunction( _function )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets the function which gives each submitted task its priority, lower
+//		values run first. See TilePriority for the default functions.
+//		
+//	Param:
+//		- PriorityFunction	|	Function to use, or nullptr to stop prioritising.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::SetPriorityFunction(PriorityFunction _function)
 {
-	m_iNumberOfThreads = std::thread::hardware_concurrency();
+	std::lock_guard<std::mutex> _lock(m_priorityMutex);
+	m_priorityFunction = _function;
 }
 
-//Constructor
-ThreadPool::ThreadPool(unsigned int _size)
+//	SetAffinity( _mode, _skipSMT )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets how workers are pinned to processors. Must be called before
+//		Initialize.
+//		
+//	Param:
+//		- AffinityMode	|	None, one core per worker, or one NUMA node per worker.
+//		- bool			|	Leave the second hyperthread of each core unused.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::SetAffinity(AffinityMode _mode, bool _skipSMT)
 {
-	//Create a pool of threads equal to specified size
-	m_iNumberOfThreads = _size;
+	m_eAffinity = _mode;
+	m_bSkipSMT = _skipSMT;
 }
 
-//Destructor
-ThreadPool::~ThreadPool()
+//	SetWorkerStartup( _function )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Sets a function each worker runs once, after pinning itself and
+//		before taking any tasks. Memory first touched here is placed on the
+//		worker's NUMA node. Must be called before Start, workers started
+//		later by Resize or the elastic policy don't run it.
+//		
+//	Param:
+//		- std::function<void(unsigned int)>	|	Function given the worker index.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::SetWorkerStartup(std::function<void(unsigned int)> _function)
 {
-	//[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~
-	m_bStop = true;
-	for (unsigned int i = 0; i < m_iNumberOfThreads; i++)
+	m_workerStartup = _function;
+}
+
+//	GetWorkerNode( _index )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Returns the NUMA node a worker was pinned to.
+//		
+//	Param:
+//		- unsigned int	|	Worker index.
+//
+//	Return: unsigned int	|	Node of the worker, 0 when not pinned.
+//
+unsigned int ThreadPool::GetWorkerNode(unsigned int _index) const
+{
+	return (_index < m_placements.size()) ? m_placements[_index].m_uiNode : 0;
+}
+
+//	ExportTrace( _path )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Writes the task events recorded since the last export to a Chrome
+//		trace JSON file. Safe to call while the workers are running.
+//		
+//	Param:
+//		- std::string	|	Path of the file to write.
+//
+//	Return: bool	|	False if tracing is off or the file couldn't be written.
+//
+bool ThreadPool::ExportTrace(const std::string& _path)
+{
+	if (m_pTracer == nullptr)
+	{
+		std::cout << "[TRACE]: Tracing is off, set TraceBufferSize in Settings.ini." << std::endl;
+		return false;
+	}
+	return m_pTracer->ExportChromeTrace(_path);
+}
+
+//	GetStats( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Reads every worker's counters and the queue depth since the last
+//		ResetStats. Safe to call while the workers are running, counts from
+//		tasks still in flight show up in the next snapshot.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: PoolStats	|	One entry per worker up to GetWorkerCount.
+//
+PoolStats ThreadPool::GetStats()
+{
+	std::lock_guard<std::mutex> _lock(m_statsMutex);
+
+	PoolStats stats;
+	if (m_pCounters == nullptr)
 	{
-		m_workerThreads[i].join();
+		return stats;
 	}
 
-	if (m_pWorkQueue != 0)
+	double ticksPerMicro = GetTicksPerMicrosecond();
+	unsigned int workers = m_iNumberOfThreads;
+	workers = (workers < m_uiMaxWorkers) ? workers : m_uiMaxWorkers;
+
+	stats.m_workers.resize(workers);
+	for (unsigned int i = 0; i < workers; i++)
 	{
-		delete m_pWorkQueue;
-		m_pWorkQueue = 0;
+		WorkerStats& worker = stats.m_workers[i];
+		worker = m_pCounters[i].Read(m_statsBase[i], ticksPerMicro);
+
+		m_pWorkQueue->get_steal_counts(i, worker.m_ulStealAttempts, worker.m_ulSteals);
+		worker.m_ulStealAttempts -= m_statsBase[i].m_ulStealAttempts;
+		worker.m_ulSteals -= m_statsBase[i].m_ulSteals;
 	}
-	//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
+
+	stats.m_ulElapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_statsResetTime).count();
+	stats.m_iQueueHighWater = m_aiQueueHighWater;
+	stats.m_ulBlockedSubmits = m_aulBlockedSubmits - m_ulBlockedSubmitsBase;
+	stats.m_ulHelpedTasks = m_aulHelpedTasks - m_ulHelpedTasksBase;
+	return stats;
 }
 
-//Singleton GetInstance
-ThreadPool& ThreadPool::GetInstance()
+//	ResetStats( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Starts the stats again from zero, along with the queue high water.
+//		The workers' counters keep running, GetStats reports the difference.
+//		
+//	Param:
+//		- n/a	|
+//
+//	Return: n/a		|
+//
+void ThreadPool::ResetStats()
 {
-	if (s_pThreadPool == nullptr)
+	std::lock_guard<std::mutex> _lock(m_statsMutex);
+
+	if (m_pCounters == nullptr)
 	{
-		int count = IniParser::GetInstance().GetValueAsInt("Tread", "ThreadCount");
-		
-		if (count > 0)
-		{
-			s_pThreadPool = new ThreadPool(count);
-		}
-		else
-		{
-			s_pThreadPool = new ThreadPool();
-		}
-		
+		return;
 	}
-	return (*s_pThreadPool);
+
+	m_statsBase.resize(m_uiMaxWorkers);
+	for (unsigned int i = 0; i < m_uiMaxWorkers; i++)
+	{
+		m_statsBase[i] = m_pCounters[i].ReadTicks();
+		m_pWorkQueue->get_steal_counts(i, m_statsBase[i].m_ulStealAttempts, m_statsBase[i].m_ulSteals);
+	}
+
+	m_statsResetTime = std::chrono::steady_clock::now();
+	m_ulBlockedSubmitsBase = m_aulBlockedSubmits;
+	m_ulHelpedTasksBase = m_aulHelpedTasks;
+	ResetQueueHighWater();
 }
 
-//Singleton Destroy Instance
-void ThreadPool::DestroyInstance()
+//	RecordPixels( _pixels )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds pixels computed by the running task to its worker's stats. Does
+//		nothing when called from a thread which isn't a worker.
+//		
+//	Param:
+//		- uint64_t	|	Number of pixels computed.
+//
+//	Return: n/a		|
+//
+void ThreadPool::RecordPixels(uint64_t _pixels)
 {
-	if (s_pThreadPool != nullptr)
+	if (tl_pCounters != nullptr)
 	{
-		delete s_pThreadPool;
+		CWorkerCounters::Add(tl_pCounters->m_aulPixels, _pixels);
 	}
-	s_pThreadPool = nullptr;
 }
 
-//	Initialize( )
+//	GetTicksPerMicrosecond( )
 //
-//	Author: Provided
-//	Access: public
+//	Author: agent
+//	Access: private
 //	Description:
-//		Initialise the threadpool variables.
+//		Measures the timestamp rate against the steady clock over the whole
+//		time since Initialize.
 //		
 //	Param:
 //		- n/a	|
 //
-//	Return: n/a		|	
+//	Return: double	|	Timestamp ticks per microsecond.
 //
-void ThreadPool::Initialize()
+double ThreadPool::GetTicksPerMicrosecond() const
 {
-	//Create a new Work Queue
-	m_pWorkQueue = new CWorkQueue<CTask>();
+	uint64_t ticks = TaskTracer::ReadTimestamp() - m_ulClockBaseTicks;
+	double micros = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_clockBaseTime).count()) / 1000.0;
+	return (micros > 0.0 && ticks > 0) ? ticks / micros : 1.0;
 }
 
-//	Start( )
+//	SetMaxQueued( _maxQueued )
 //
-//	Author: Provided
+//	Author: agent
 //	Access: public
 //	Description:
-//		Add N threads to the vector of threads.
+//		Bounds how many tasks can wait in the queue. Submits from other
+//		threads block, or fail for TrySubmit and SubmitFor, until workers
+//		make room, so a huge job never holds more than this many tasks in
+//		memory at once. Must be called before Initialize.
 //		
 //	Param:
-//		- n/a	|
+//		- unsigned int	|	Most tasks queued at once, 0 for no limit.
 //
 //	Return: n/a		|	
 //
-void ThreadPool::Start()
+void ThreadPool::SetMaxQueued(unsigned int _maxQueued)
 {
-	for (unsigned int i = 0; i < m_iNumberOfThreads; i++)
-	{
-		m_workerThreads.push_back(std::thread(&ThreadPool::DoWork, this));
-	}
+	m_uiMaxQueued = _maxQueued;
 }
 
-//	Submit( _fItem )
+//	SetIdlePolicy( _spinCount, _yieldCount )
 //
-//	Author: Provided
+//	Author: agent
 //	Access: public
 //	Description:
-//		Adds a task to the back of the work queue.
+//		Sets how long an idle worker keeps looking for work before it parks.
+//		It first spins _spinCount times with a pause instruction, then yields
+//		its time slice _yieldCount times. Zero for both parks straight away.
 //		
 //	Param:
-//		- CTask		|	Task to add to the list of tasks.
+//		- unsigned int	|	Times to spin.
+//		- unsigned int	|	Times to yield.
 //
 //	Return: n/a		|	
 //
-void ThreadPool::Submit(CTask _fItem)
+void ThreadPool::SetIdlePolicy(unsigned int _spinCount, unsigned int _yieldCount)
 {
-	m_pWorkQueue->push(_fItem);
-	m_TotalItems++;
+	m_uiIdleSpinCount = _spinCount;
+	m_uiIdleYieldCount = _yieldCount;
 }
 
 //	Stop( )
@@ -162,6 +1266,7 @@ void ThreadPool::Submit(CTask _fItem)
 void ThreadPool::Stop()
 {
 	m_bStop = true;
+	m_workSignal.NotifyAll();
 }
 
 //	HasItemsRemaining( )
@@ -181,52 +1286,338 @@ bool ThreadPool::HasItemsRemaining()
 	return (m_TotalItems > m_aiItemsProcessed);
 }
 
-//	DoWork( )
+//	WaitForWork( _index )
+//
+//	Author:	agent
+//	Access: private
+//	Description:
+//		Called by an idle worker. Returns as soon as tasks are queued, the
+//		pool is stopping or shrinks past this worker, spinning then yielding
+//		then parking while it waits. With an elastic policy a worker that
+//		stays parked for the retire time is told to leave.
+//		
+//	Param:
+//		- unsigned int	|	Worker slot of the caller.
+//
+//	Return: bool	|	False if the worker has been idle long enough to leave.
+//
+bool ThreadPool::WaitForWork(unsigned int _index)
+{
+	for (unsigned int i = 0; i < m_uiIdleSpinCount; i++)
+	{
+		if (m_aiQueued > 0 || m_bStop || _index >= m_iNumberOfThreads)
+		{
+			return true;
+		}
+		CpuRelax();
+	}
+
+	for (unsigned int i = 0; i < m_uiIdleYieldCount; i++)
+	{
+		if (m_aiQueued > 0 || m_bStop || _index >= m_iNumberOfThreads)
+		{
+			return true;
+		}
+		std::this_thread::yield();
+	}
+
+	unsigned int key = m_workSignal.PrepareWait();
+	if (m_aiQueued > 0 || m_bStop || _index >= m_iNumberOfThreads)
+	{
+		m_workSignal.CancelWait();
+		return true;
+	}
+
+	if (m_uiRetireMilliseconds == 0 || _index < m_uiMinWorkers)
+	{
+		m_workSignal.Wait(key);
+		return true;
+	}
+	return m_workSignal.WaitFor(key, m_uiRetireMilliseconds);
+}
+
+//	DoWork( _index, _startup )
 //
 //	Author:	Provided
 //	Access: public
 //	Description:
-//		Main function for the worker thread.
+//		Main function for the worker thread. Returns when the pool stops,
+//		shrinks past this worker or retires it for being idle.
 //		
 //	Param:
-//		- n/a	|
+//		- unsigned int					|	Worker slot owned by this thread.
+//		- std::shared_ptr<TaskGroup>	|	Told once the worker is ready, empty
+//										for workers started after Start.
 //
 //	Return: n/a		|	
 //
-void ThreadPool::DoWork()
+void ThreadPool::DoWork(unsigned int _index, std::shared_ptr<TaskGroup> _startup)
 {
 	//[MY WORK] Start: ~~~~~~~~~~~~~~~~~~~~
 	//Entry point of  a thread.
-	std::cout << std::endl << "Thread with id [" << std::this_thread::get_id() << "] starting........" << std::endl;
-	//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
-	while (!m_bStop)
+	if (m_bLogTasks)
 	{
-		CTask WorkItem;
+		std::cout << std::endl << "Thread with id [" << std::this_thread::get_id() << "] starting........" << std::endl;
+	}
+	//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
+	m_pWorkQueue->bind_worker(_index);
+	m_pBackgroundQueue->bind_worker(_index);
+	tl_pWorkerOf = this;
 
-		//If there is an item in the queue to be processed; just take it off the q and process it
-		if (m_pWorkQueue->blocking_pop(WorkItem, 500))
+	if (_index < m_placements.size())
+	{
+		CpuAffinity::PinCurrentThread(m_placements[_index].m_cpus);
+	}
+	if (_startup)
+	{
+		if (m_workerStartup)
 		{
-			//[MY WORK] Start ~~~~~~~~~~~~~~~~~~~~
-			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
-			//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
+			m_workerStartup(_index);
+		}
+		_startup->Done();
+	}
 
-			WorkItem();
+	//Only this thread writes to its ring and its counters
+	CTraceRing* trace = (m_pTracer != nullptr) ? &m_pTracer->GetRing(_index) : nullptr;
+	CWorkerCounters& counters = m_pCounters[_index];
+	tl_pCounters = &counters;
 
-			//[MY WORK] Start ~~~~~~~~~~~~~~~~~~~~
-			std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	//Tasks taken off the queue in one go
+	std::vector<CFunctionTask> batch((m_uiPopBatchSize > 0) ? m_uiPopBatchSize : 1);
+
+	bool retiring = false;
+	unsigned int turn = 0;
+	for (;;)
+	{
+		if (m_bStop || _index >= m_iNumberOfThreads || retiring)
+		{
+			//Leave the pool, unless a Resize or new tasks want this worker after all
+			std::lock_guard<std::mutex> _lock(m_workersMutex);
+			if (m_bStop || _index >= m_iNumberOfThreads || m_aiQueued == 0)
+			{
+				m_workerLive[_index] = false;
+				m_uiLiveWorkers--;
+				tl_pCounters = nullptr;
+				return;
+			}
+			retiring = false;
+		}
 
-			auto time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-			std::cout << "Thread [" << std::this_thread::get_id() << "] finished: " << WorkItem.ToString() << "in " << time << "microseconds." << std::endl;
-			//[MY WORK] End ~~~~~~~~~~~~~~~~~~~~
+		//Interactive work goes first, unless it is background work's turn
+		QoSClass popped = QOS_INTERACTIVE;
+		if (m_uiBackgroundEvery > 0 && ++turn >= m_uiBackgroundEvery)
+		{
+			turn = 0;
+			popped = QOS_BACKGROUND;
+		}
 
-			m_aiItemsProcessed++;
+		size_t count = PopWork(popped, batch);
+		if (count == 0)
+		{
+			popped = (popped == QOS_INTERACTIVE) ? QOS_BACKGROUND : QOS_INTERACTIVE;
+			count = PopWork(popped, batch);
 		}
-		//Else just continue back to the beginning of the while loop.
-		else
+
+		//If the queue is empty spin, yield, then park until an item is pushed
+		if (count == 0)
 		{
+			uint64_t idleFrom = TaskTracer::ReadTimestamp();
+			retiring = !WaitForWork(_index);
+			CWorkerCounters::Add(counters.m_aulIdleTicks, TaskTracer::ReadTimestamp() - idleFrom);
 			continue;
 		}
+		m_aiQueuedByClass[popped] -= static_cast<int>(count);
+		m_aiQueued -= static_cast<int>(count);
+		m_spaceSignal.NotifyAll();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			RunTask(batch[i], &counters, trace, _index);
+		}
+
+		m_aiItemsProcessed += static_cast<int>(count);
+	}
+}
+
+//	RunTask( _task, _pCounters, _trace, _index )
+//
+//	Author:	agent
+//	Access: private
+//	Description:
+//		Runs a task taken off the queue, or discards it if its group was
+//		cancelled while it was queued, then tells the group and releases it.
+//		
+//	Param:
+//		- CFunctionTask&		|	Task to run, left empty.
+//		- CWorkerCounters*	|	Counters of the running worker, may be null.
+//		- CTraceRing*		|	Trace ring of the running worker, may be null.
+//		- unsigned int		|	Worker slot recorded in the trace.
+//
+//	Return: n/a		|	
+//
+void ThreadPool::RunTask(CFunctionTask& _task, CWorkerCounters* _pCounters, CTraceRing* _trace, unsigned int _index)
+{
+	uint64_t start = TaskTracer::ReadTimestamp();
+	unsigned long long iterations = 0;
+
+	//Drop tasks whose generation was cancelled while they were queued, or
+	//which wouldn't finish before their group's deadline
+	TaskGroup* group = _task.GetGroup();
+	bool timed = group != nullptr && group->HasDeadline();
+	std::chrono::steady_clock::time_point started = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+	bool dropped = group != nullptr && (group->IsCancelled() || (timed && group->ExpireIfLate(started)));
+	if (dropped)
+	{
+		_task.Discard();
+	}
+	else
+	{
+		iterations = _task();
+		if (timed)
+		{
+			group->RecordRunTime(started);
+		}
+	}
+	uint64_t end = TaskTracer::ReadTimestamp();
+
+	if (_pCounters != nullptr)
+	{
+		if (_task.GetQueuedAt() != 0 && start > _task.GetQueuedAt())
+		{
+			CWorkerCounters::Add(_pCounters->m_aulQueueWaitTicks, start - _task.GetQueuedAt());
+		}
+		CWorkerCounters::Add(dropped ? _pCounters->m_aulDropped : _pCounters->m_aulTasks, 1);
+		CWorkerCounters::Add(_pCounters->m_aulBusyTicks, end - start);
+		CWorkerCounters::Add(_pCounters->m_aulIterations, iterations);
+	}
+
+	if (_trace != nullptr)
+	{
+		TraceEvent event;
+		event.m_ulStart = start;
+		event.m_ulEnd = end;
+		event.m_ulIterations = iterations;
+		event.m_iTileX = _task.GetTraceX();
+		event.m_iTileY = _task.GetTraceY();
+		event.m_uiGeneration = _task.GetGeneration();
+		event.m_usWorker = static_cast<uint16_t>(_index);
+		event.m_usDropped = dropped ? 1 : 0;
+		_trace->Record(event);
+	}
+
+	if (_task.GetGroup() != nullptr)
+	{
+		_task.GetGroup()->Done();
+	}
+
+	//Release the callable and group now rather than on the next pop
+	_task.Reset();
+}
+
+//	HelpWhileWaiting( _group, _deadline )
+//
+//	Author:	agent
+//	Access: public
+//	Description:
+//		Runs queued interactive tasks on the calling thread until _group is
+//		complete, the deadline passes or nothing is left to take. Lets a
+//		thread which would otherwise sit waiting, like the GLUT thread, add
+//		its core to the pool and still get back in time to redraw. Only
+//		helpable tasks are run, so the deadline can be overrun by up to one
+//		tile, or one chain of graph nodes. Any other task is put back for
+//		the workers and helping stops there.
+//		
+//	Param:
+//		- std::shared_ptr<TaskGroup>				|	Group being waited on.
+//		- std::chrono::steady_clock::time_point	|	When to stop helping.
+//
+//	Return: bool	|	True if the group is complete.
+//
+bool ThreadPool::HelpWhileWaiting(std::shared_ptr<TaskGroup> _group, std::chrono::steady_clock::time_point _deadline)
+{
+	if (!_group)
+	{
+		return true;
+	}
+
+	CFunctionTask task;
+	while (!_group->IsComplete() && std::chrono::steady_clock::now() < _deadline)
+	{
+		//Only interactive work, a background tile could overrun the deadline
+		if (m_pWorkQueue == nullptr || m_pWorkQueue->pop_batch(&task, 1) == 0)
+		{
+			break;
+		}
+
+		//Claim loops and ParallelFor helpers run until their shared work is
+		//gone, which could be the rest of the frame. Still counted as queued,
+		//so workers don't park while it is out of the queue.
+		if (!task.IsHelpable())
+		{
+			if (!m_pWorkQueue->try_push(task))
+			{
+				m_pOverflowQueue->push(std::move(task));
+				m_aiOverflowed++;
+			}
+			m_workSignal.NotifyOne();
+			break;
+		}
+		m_aiQueuedByClass[QOS_INTERACTIVE]--;
+		m_aiQueued--;
+		m_spaceSignal.NotifyAll();
+
+		//Workers count into their own slot, other threads only into the total
+		RunTask(task, tl_pCounters, nullptr, 0);
+		if (tl_pCounters == nullptr)
+		{
+			m_aulHelpedTasks++;
+		}
+		m_aiItemsProcessed++;
+	}
+	return _group->IsComplete();
+}
+
+//	PopWork( _class, _batch )
+//
+//	Author:	agent
+//	Access: private
+//	Description:
+//		Takes tasks of one class off its queue. Interactive tasks come a fair
+//		share of what is queued at a time, up to the batch size. Background
+//		tasks come one at a time, so the worker looks for interactive work
+//		again after every background tile. Interactive tasks which
+//		overflowed the ring are taken before the ring's.
+//		
+//	Param:
+//		- QoSClass						|	Class to take tasks of.
+//		- std::vector<CFunctionTask>&	|	Worker's batch to fill.
+//
+//	Return: size_t	|	Number of tasks taken.
+//
+size_t ThreadPool::PopWork(QoSClass _class, std::vector<CFunctionTask>& _batch)
+{
+	if (_class == QOS_BACKGROUND)
+	{
+		return m_pBackgroundQueue->pop_batch(&_batch[0], 1);
+	}
+
+	//Sized from the pool's own count, asking the queue would lock it twice
+	unsigned int live = m_uiLiveWorkers;
+	int queued = m_aiQueuedByClass[QOS_INTERACTIVE];
+	size_t grab = ((queued > 0) ? static_cast<size_t>(queued) : 0) / ((live > 0) ? live : 1);
+	grab = (grab < 1) ? 1 : ((grab > _batch.size()) ? _batch.size() : grab);
+
+	//Overflowed tasks were pushed after the ring filled, take them first
+	if (m_aiOverflowed > 0)
+	{
+		size_t count = m_pOverflowQueue->pop_batch(&_batch[0], grab);
+		if (count > 0)
+		{
+			m_aiOverflowed -= static_cast<int>(count);
+			return count;
+		}
 	}
+	return m_pWorkQueue->pop_batch(&_batch[0], grab);
 }
 
 //	getItemsProcessed( )
@@ -246,3 +1637,64 @@ std::atomic_int& ThreadPool::getItemsProcessed()
 	return m_aiItemsProcessed;
 }
 
+
+//	ParseQueueType( _name )
+//
+//	Author:	agent
+//	Access: public
+//	Description:
+//		Converts the QueueType value from Settings.ini into a QueueType.
+//		Unknown names fall back to the shared queue.
+//		
+//	Param:
+//		- std::string	|	Name of the queue type, e.g. "Shared", "Stealing", "Ring" or "Priority".
+//
+//	Return: QueueType	|	Matching queue type.
+//
+QueueType ThreadPool::ParseQueueType(const std::string& _name)
+{
+	if (_name == "Stealing")
+	{
+		return QUEUE_STEALING;
+	}
+	if (_name == "Ring")
+	{
+		return QUEUE_RING;
+	}
+	if (_name == "Priority")
+	{
+		return QUEUE_PRIORITY;
+	}
+	return QUEUE_SHARED;
+}
+
+//	QueueTypeToString( _type )
+//
+//	Author:	agent
+//	Access: public
+//	Description:
+//		Converts a QueueType into the name used by Settings.ini.
+//		
+//	Param:
+//		- QueueType		|	Queue type to convert.
+//
+//	Return: std::string	|	Name of the queue type.
+//
+std::string ThreadPool::QueueTypeToString(QueueType _type)
+{
+	switch (_type)
+	{
+	case QUEUE_STEALING:
+		return "Stealing";
+
+	case QUEUE_RING:
+		return "Ring";
+
+	case QUEUE_PRIORITY:
+		return "Priority";
+
+	case QUEUE_SHARED:
+	default:
+		return "Shared";
+	}
+}
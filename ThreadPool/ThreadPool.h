@@ -10,7 +10,7 @@
 // (c) 2020 Media Design School
 //
 // File Name    |	ThreadPool.h
-// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com)
+// Author(s)    |	Provided and updated by Michael Jordan (Michael.jor8834@mediadesign.com), agent (agent@local)
 // Class(es)	|	ThreadPool
 // Description:
 //		Thread pool to hold tasks and distribute them to working threads.
@@ -22,34 +22,152 @@
 #include <atomic>
 #include <functional>
 #include <condition_variable>
+#include <mutex>
+#include <string>
+#include <chrono>
 
 //Local Includes
-#include "WorkQueue.h"
+#include "WorkQueueADT.h"
 #include "Task.h"
+#include "TaskGroup.h"
+#include "FunctionTask.h"
+#include "Range2D.h"
+#include "TilePriority.h"
+#include "TaskTracer.h"
+#include "CpuAffinity.h"
+#include "EventCount.h"
+#include "Coroutine.h"
+#include "TaskGraph.h"
+#include "WorkerStats.h"
+#include "ThreadPoolConfig.h"
 
 class ThreadPool
 {
+	friend class Benchmark;
+
 public:
+	//Independent pool, call Initialize and Start before submitting
+	explicit ThreadPool(const ThreadPoolConfig& _config);
 	~ThreadPool();
 
-	// Singleton Methods
+	//Default pool configured from Settings.ini
 	static ThreadPool& GetInstance();
 	static void DestroyInstance();
 
+	//Pool the calling thread is a worker of, null on any other thread
+	static ThreadPool* GetCurrent() { return tl_pWorkerOf; };
+
+	//Configuration the pool was built with, Resize and the setters aren't reflected
+	const ThreadPoolConfig& GetConfig() const { return m_config; };
+
 	void Initialize();
-	void Submit(CTask _iworkItem);
-	void DoWork();
+	TaskHandle Submit(CTask _iworkItem, std::shared_ptr<TaskGroup> _group = nullptr);
+	TaskHandle SubmitBatch(CTask* _pItems, size_t _count, std::shared_ptr<TaskGroup> _group = nullptr);
+	TaskHandle Submit(CFunctionTask _task, std::shared_ptr<TaskGroup> _group = nullptr);
+	TaskHandle SubmitBatch(CFunctionTask* _pTasks, size_t _count, std::shared_ptr<TaskGroup> _group = nullptr);
+	void Post(CFunctionTask _task);
+
+	//Submits which give up when the queue is full, the task is only moved
+	//from if it was queued. The handle is invalid if it wasn't.
+	TaskHandle TrySubmit(CFunctionTask& _task, std::shared_ptr<TaskGroup> _group = nullptr);
+	TaskHandle SubmitFor(CFunctionTask& _task, unsigned int _milliseconds, std::shared_ptr<TaskGroup> _group = nullptr);
+	TaskHandle Run(TaskGraph& _graph, std::shared_ptr<TaskGroup> _group = nullptr);
+
+	//co_await in a CoTask to carry on on a worker, queued in the given class
+	ScheduleAwaiter Schedule(QoSClass _class = QOS_INTERACTIVE) { return ScheduleAwaiter(this, _class); };
+
+	//Data parallel helpers, the calling thread works too
+	template<typename F>
+	void ParallelFor(const Range2D& _range, unsigned int _grain, F _function);
+	template<typename T, typename F, typename C>
+	T ParallelReduce(const Range2D& _range, unsigned int _grain, T _identity, F _function, C _combine);
+	void DoWork(unsigned int _index, std::shared_ptr<TaskGroup> _startup);
+
+	//Runs queued tiles on the calling thread while it waits for the group
+	bool HelpWhileWaiting(std::shared_ptr<TaskGroup> _group, std::chrono::steady_clock::time_point _deadline);
 	void Start();
 	void Stop();
+
+	//Changes the number of workers while running, up to GetMaxWorkerCount
+	void Resize(unsigned int _count);
+	void SetElasticPolicy(unsigned int _minWorkers, unsigned int _retireMilliseconds);
 	
 	bool HasItemsRemaining();
 
 	std::atomic_int& getItemsProcessed();
 
+	void SetPriorityFunction(PriorityFunction _function);
+
+	bool ExportTrace(const std::string& _path);
+
+	void SetIdlePolicy(unsigned int _spinCount, unsigned int _yieldCount);
+	void SetMaxQueued(unsigned int _maxQueued);
+	unsigned int GetMaxQueued() const { return m_uiMaxQueued; };
+	void SetAffinity(AffinityMode _mode, bool _skipSMT);
+	void SetWorkerStartup(std::function<void(unsigned int)> _function);
+	unsigned int GetWorkerCount() const { return m_iNumberOfThreads; };
+	unsigned int GetLiveWorkerCount() const { return m_uiLiveWorkers; };
+	unsigned int GetMaxWorkerCount() const { return m_uiMaxWorkers; };
+	unsigned int GetWorkerNode(unsigned int _index) const;
+
+	QueueType GetQueueType() const { return m_eQueueType; };
+	static QueueType ParseQueueType(const std::string& _name);
+	static std::string QueueTypeToString(QueueType _type);
+
+	//Queue depth, the deepest it has been since the last reset and how
+	//many submits had to wait for space
+	int GetQueueDepth() const { return m_aiQueued; };
+	int GetQueueDepth(QoSClass _class) const { return m_aiQueuedByClass[_class]; };
+	int GetQueueHighWater() const { return m_aiQueueHighWater; };
+	void ResetQueueHighWater() { m_aiQueueHighWater = m_aiQueued.load(); };
+	uint64_t GetBlockedSubmits() const { return m_aulBlockedSubmits; };
+
+	//Per worker load since the last ResetStats, which also resets the high water
+	PoolStats GetStats();
+	void ResetStats();
+
+	//Called by tasks to count pixels against the worker running them
+	static void RecordPixels(uint64_t _pixels);
+
 private:
-	// Make the threadpool a singleton
-	ThreadPool();
-	ThreadPool(unsigned int _size);
+	bool WaitForWork(unsigned int _index);
+	double GetTicksPerMicrosecond() const;
+	void SpawnWorkers();
+	size_t PopWork(QoSClass _class, std::vector<CFunctionTask>& _batch);
+	void RunTask(CFunctionTask& _task, CWorkerCounters* _pCounters, CTraceRing* _trace, unsigned int _index);
+	void Enqueue(CFunctionTask* _pTasks, size_t _count);
+	bool ReserveQueue(int _count, unsigned int _milliseconds, QoSClass _class);
+	bool TryReserveQueue(int _count, QoSClass _class);
+	void PushReserved(CFunctionTask* _pTasks, size_t _count);
+
+	//Queued in place of a TaskGraph node, runs it and then its ready successors
+	struct GraphNodeTask
+	{
+		ThreadPool* m_pPool;
+		TaskGraph* m_pGraph;
+		unsigned int m_uiNode;
+
+		unsigned long long operator()() { return m_pPool->RunNode(m_pGraph, m_uiNode, false); };
+		void Discard() { m_pPool->RunNode(m_pGraph, m_uiNode, true); };
+	};
+	CFunctionTask MakeNodeTask(TaskGraph* _pGraph, unsigned int _node);
+	unsigned long long RunNode(TaskGraph* _pGraph, unsigned int _node, bool _discard);
+
+	//Shared by the caller and helper tasks of one ParallelFor/ParallelReduce
+	struct ParallelState
+	{
+		std::vector<Range2D> m_chunks;
+		std::atomic_uint m_uiNextChunk{ 0 };
+		TaskGroup m_chunksDone;
+
+		//Type erased body, only valid until every chunk is done
+		void* m_pBody = nullptr;
+		void(*m_invoke)(void* _body, const Range2D& _chunk, unsigned int _participant) = nullptr;
+
+		void Run(unsigned int _participant);
+	};
+
+	void RunParallel(const Range2D& _range, unsigned int _grain, void* _pBody, void(*_invoke)(void*, const Range2D&, unsigned int));
 
 	//The ThreadPool is non-copyable.
 	ThreadPool(const ThreadPool& _kr) = delete;
@@ -59,21 +177,183 @@ protected:
 	static ThreadPool* s_pThreadPool;
 
 private:
+	ThreadPoolConfig m_config;
+
 	//An atomic boolean variable to stop all threads in the threadpool.
 	std::atomic_bool m_bStop{ false };
 
 	//A WorkQueue of tasks which are functors
-	CWorkQueue<CTask >* m_pWorkQueue;
+	WorkQueueADT<CFunctionTask>* m_pWorkQueue = nullptr;
+
+	//Background tasks wait here and only run when no interactive task is
+	//queued, except every m_uiBackgroundEvery turns so they aren't starved
+	WorkQueueADT<CFunctionTask>* m_pBackgroundQueue = nullptr;
+	unsigned int m_uiBackgroundEvery = 0;
+
+	//Tasks a worker pushes while the ring is full, or a helping thread
+	//puts back. Neither waits for room, workers are the ones meant to make
+	//it. Only made for the ring.
+	WorkQueueADT<CFunctionTask>* m_pOverflowQueue = nullptr;
+	std::atomic_int m_aiOverflowed{ 0 };
+
+	//Which WorkQueue implementation Initialize creates
+	QueueType m_eQueueType = QUEUE_SHARED;
+
+	//Number of slots in fixed capacity queues
+	unsigned int m_uiQueueCapacity = 4096;
+
+	//Most tasks a worker takes off the queue at once
+	unsigned int m_uiPopBatchSize = 4;
+
+	//Tasks submitted but not yet taken by a worker, idle workers watch this
+	std::atomic_int m_aiQueued{ 0 };
+	std::atomic_int m_aiQueuedByClass[QOS_COUNT] = {};
+	std::atomic_int m_aiQueueHighWater{ 0 };
+
+	//Most tasks of each class queued at once, 0 for no limit. Submits from
+	//outside the pool wait here for workers to make room, workers never wait.
+	unsigned int m_uiMaxQueued = 0;
+	CEventCount m_spaceSignal;
+	std::atomic<uint64_t> m_aulBlockedSubmits{ 0 };
+	static const unsigned int WAIT_FOREVER = 0xFFFFFFFF;
 
-	//Create a pool of worker threads
+	//Pool the calling thread works for, if any
+	static thread_local ThreadPool* tl_pWorkerOf;
+
+	//Stats of each worker slot, only written by the worker in the slot
+	CWorkerCounters* m_pCounters = nullptr;
+	static thread_local CWorkerCounters* tl_pCounters;
+
+	//Counter values at the last ResetStats, times in timestamp ticks
+	std::vector<WorkerTicks> m_statsBase;
+	uint64_t m_ulBlockedSubmitsBase = 0;
+
+	//Tasks run by threads outside the pool in HelpWhileWaiting
+	std::atomic<uint64_t> m_aulHelpedTasks{ 0 };
+	uint64_t m_ulHelpedTasksBase = 0;
+	std::chrono::steady_clock::time_point m_statsResetTime;
+	std::mutex m_statsMutex;
+
+	//Converts timestamp ticks to time for the stats
+	uint64_t m_ulClockBaseTicks = 0;
+	std::chrono::steady_clock::time_point m_clockBaseTime;
+
+	//Idle workers park here, submits and Stop wake them
+	CEventCount m_workSignal;
+	unsigned int m_uiIdleSpinCount = 1000;
+	unsigned int m_uiIdleYieldCount = 8;
+
+	//Gives each submitted task its priority, may be empty
+	PriorityFunction m_priorityFunction;
+	std::mutex m_priorityMutex;
+
+	//Print a line as each worker starts
+	bool m_bLogTasks = true;
+
+	//Events recorded per worker, 0 turns tracing off
+	unsigned int m_uiTraceCapacity = 0;
+	TaskTracer* m_pTracer = nullptr;
+
+	//Where each worker is pinned, planned by Initialize
+	AffinityMode m_eAffinity = AFFINITY_NONE;
+	bool m_bSkipSMT = false;
+	std::vector<WorkerPlacement> m_placements;
+
+	//Run by each worker before it takes any tasks, Start waits for them all
+	std::function<void(unsigned int)> m_workerStartup;
+	std::shared_ptr<TaskGroup> m_pStartupGroup;
+
+	//Create a pool of worker threads, one slot per possible worker
 	std::vector<std::thread> m_workerThreads;
+	std::vector<bool> m_workerLive;
+	std::mutex m_workersMutex;
+	std::atomic_uint m_uiLiveWorkers{ 0 };
 
 	//A variable to hold the number of threads we want in the pool
-	unsigned int m_iNumberOfThreads;
+	std::atomic_uint m_iNumberOfThreads{ 0 };
+
+	//Most workers Resize can ask for, queues and traces are sized for this many
+	unsigned int m_uiMaxWorkers = 0;
+
+	//Idle workers past the first m_uiMinWorkers leave after this long parked,
+	//the next burst of submits starts them again. 0 keeps them all.
+	unsigned int m_uiMinWorkers = 1;
+	unsigned int m_uiRetireMilliseconds = 0;
 	
 
 	//An atomic variable to keep track of how many items have been processed.
 	std::atomic_int m_aiItemsProcessed{ 0 };
 	std::atomic_int m_TotalItems{ 0 };
 };
+
+//	ParallelFor( _range, _grain, _function )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Splits _range into chunks of at least _grain cells and calls
+//		_function(const Range2D&) on each, spread over the workers and the
+//		calling thread. Returns once every chunk is done.
+//
+//	Param:
+//		- Range2D&		|	Cells to cover.
+//		- unsigned int	|	Fewest cells worth giving to one call.
+//		- F				|	Function to call on each chunk.
+//
+//	Return: n/a		|
+//
+template<typename F>
+void ThreadPool::ParallelFor(const Range2D& _range, unsigned int _grain, F _function)
+{
+	RunParallel(_range, _grain, &_function, [](void* _body, const Range2D& _chunk, unsigned int)
+	{
+		(*static_cast<F*>(_body))(_chunk);
+	});
+}
+
+//	ParallelReduce( _range, _grain, _identity, _function, _combine )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Like ParallelFor, but _function(const Range2D&, T& partial) adds each
+//		chunk into a partial result owned by the thread running it. The
+//		partials are merged with _combine(T, T) on the calling thread.
+//
+//	Param:
+//		- Range2D&		|	Cells to cover.
+//		- unsigned int	|	Fewest cells worth giving to one call.
+//		- T				|	Starting value of every partial result.
+//		- F				|	Function to accumulate a chunk into a partial.
+//		- C				|	Function merging two partial results.
+//
+//	Return: T	|	Every partial result merged together.
+//
+template<typename T, typename F, typename C>
+T ThreadPool::ParallelReduce(const Range2D& _range, unsigned int _grain, T _identity, F _function, C _combine)
+{
+	//One partial per participant, padded so threads don't share cache lines
+	struct Partial
+	{
+		alignas(64) T m_value;
+	};
+	std::vector<Partial> partials(m_uiMaxWorkers + 1, Partial{ _identity });
+
+	auto body = [&_function, &partials](const Range2D& _chunk, unsigned int _participant)
+	{
+		_function(_chunk, partials[_participant].m_value);
+	};
+	RunParallel(_range, _grain, &body, [](void* _body, const Range2D& _chunk, unsigned int _participant)
+	{
+		(*static_cast<decltype(body)*>(_body))(_chunk, _participant);
+	});
+
+	T result = _identity;
+	for (size_t i = 0; i < partials.size(); i++)
+	{
+		result = _combine(result, partials[i].m_value);
+	}
+	return result;
+}
+
 #endif
@@ -0,0 +1,53 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	ThreadPoolConfig.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ThreadPoolConfig
+// Description:
+//		Everything a ThreadPool is built with. Filled in by hand to run
+//		several differently configured pools side by side, or loaded from a
+//		section of Settings.ini for the default instance.
+//
+
+//Self Include
+#include "ThreadPoolConfig.h"
+
+//Local Includes
+#include "ThreadPool.h"
+#include "IniParser.h"
+
+//	LoadFromIni( _section )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Reads a pool configuration from the loaded .ini file. Every key must
+//		be in the section, GameScene::LoadSettings adds the defaults.
+//
+//	Param:
+//		- std::string	|	Section of the .ini file to read.
+//
+//	Return: ThreadPoolConfig	|	Configuration read from the file.
+//
+ThreadPoolConfig ThreadPoolConfig::LoadFromIni(const std::string& _section)
+{
+	IniParser& ini = IniParser::GetInstance();
+
+	ThreadPoolConfig config;
+	int count = ini.GetValueAsInt(_section, "ThreadCount");
+	config.m_uiThreadCount = (count > 0) ? count : 0;
+	config.m_eQueueType = ThreadPool::ParseQueueType(ini.GetValueAsString(_section, "QueueType"));
+	config.m_uiQueueCapacity = ini.GetValueAsInt(_section, "QueueCapacity");
+	config.m_uiPopBatchSize = ini.GetValueAsInt(_section, "PopBatchSize");
+	config.m_uiMaxQueued = ini.GetValueAsInt(_section, "MaxQueuedTasks");
+	config.m_uiIdleSpinCount = ini.GetValueAsInt(_section, "IdleSpinCount");
+	config.m_uiIdleYieldCount = ini.GetValueAsInt(_section, "IdleYieldCount");
+	config.m_uiMinWorkers = ini.GetValueAsInt(_section, "MinThreadCount");
+	config.m_uiRetireMilliseconds = ini.GetValueAsInt(_section, "IdleRetireMs");
+	config.m_uiBackgroundEvery = ini.GetValueAsInt(_section, "BackgroundEvery");
+	config.m_uiTraceCapacity = ini.GetValueAsInt(_section, "TraceBufferSize");
+	config.m_eAffinity = CpuAffinity::ParseMode(ini.GetValueAsString(_section, "Affinity"));
+	config.m_bSkipSMT = ini.GetValueAsBoolean(_section, "SkipSMT");
+	return config;
+}
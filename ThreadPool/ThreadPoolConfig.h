@@ -0,0 +1,67 @@
+#ifndef __THREADPOOLCONFIG_H__
+#define __THREADPOOLCONFIG_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	ThreadPoolConfig.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	ThreadPoolConfig
+// Description:
+//		Everything a ThreadPool is built with. Filled in by hand to run
+//		several differently configured pools side by side, or loaded from a
+//		section of Settings.ini for the default instance.
+//
+
+//Library Includes
+#include <string>
+
+//Local Includes
+#include "CpuAffinity.h"
+
+//Enums
+enum QueueType
+{
+	QUEUE_SHARED, QUEUE_STEALING, QUEUE_RING, QUEUE_PRIORITY
+};
+
+struct ThreadPoolConfig
+{
+	//Workers to start with, 0 for one per hardware thread
+	unsigned int m_uiThreadCount = 0;
+
+	//Most workers Resize can ask for, 0 for the larger of the thread
+	//count and the hardware thread count
+	unsigned int m_uiMaxThreadCount = 0;
+
+	QueueType m_eQueueType = QUEUE_SHARED;
+	unsigned int m_uiQueueCapacity = 4096;
+	unsigned int m_uiPopBatchSize = 4;
+
+	//Most tasks queued at once before submits wait, 0 for no limit
+	unsigned int m_uiMaxQueued = 0;
+
+	//Idle workers spin, then yield, then park. Workers past the first
+	//m_uiMinWorkers leave after m_uiRetireMilliseconds parked, 0 keeps them.
+	unsigned int m_uiIdleSpinCount = 1000;
+	unsigned int m_uiIdleYieldCount = 8;
+	unsigned int m_uiMinWorkers = 1;
+	unsigned int m_uiRetireMilliseconds = 0;
+
+	//Every this many turns a worker takes background work before
+	//interactive work, 0 only runs it when no interactive work is queued
+	unsigned int m_uiBackgroundEvery = 0;
+
+	//Events recorded per worker, 0 turns tracing off
+	unsigned int m_uiTraceCapacity = 0;
+
+	AffinityMode m_eAffinity = AFFINITY_NONE;
+	bool m_bSkipSMT = false;
+
+	//Print a line as each worker starts
+	bool m_bLogWorkers = true;
+
+	static ThreadPoolConfig LoadFromIni(const std::string& _section = "Tread");
+};
+
+#endif // !__THREADPOOLCONFIG_H__
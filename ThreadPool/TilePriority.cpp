@@ -0,0 +1,83 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	TilePriority.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TilePriority
+// Description:
+//		Factory of priority functions for ThreadPool::SetPriorityFunction.
+//		Lower values are computed first.
+//
+
+//Self Include
+#include "TilePriority.h"
+
+//Library Includes
+#include <cmath>
+
+//Local Includes
+#include "Task.h"
+
+//	DistanceFromPoint( _x, _y )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Orders tiles by the distance from their centre to a point on the
+//		screen, e.g. the cursor.
+//
+//	Param:
+//		- float		|	Screen x coordinate of the point.
+//		- float		|	Screen y coordinate of the point.
+//
+//	Return: PriorityFunction	|	Function to give to the ThreadPool.
+//
+PriorityFunction TilePriority::DistanceFromPoint(float _x, float _y)
+{
+	return [_x, _y](const CTask& _task)
+	{
+		float dx = _task.GetCenterX() - _x;
+		float dy = _task.GetCenterY() - _y;
+		return sqrtf(dx * dx + dy * dy);
+	};
+}
+
+//	SpiralCenterOut( _centerX, _centerY, _ringSize )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Orders tiles in square rings around a centre point, walking each ring
+//		clockwise, so the image grows outwards in a spiral.
+//
+//	Param:
+//		- float		|	Screen x coordinate of the centre.
+//		- float		|	Screen y coordinate of the centre.
+//		- float		|	Width of each ring in pixels, usually the tile size.
+//
+//	Return: PriorityFunction	|	Function to give to the ThreadPool.
+//
+PriorityFunction TilePriority::SpiralCenterOut(float _centerX, float _centerY, float _ringSize)
+{
+	if (_ringSize < 1.0f)
+	{
+		_ringSize = 1.0f;
+	}
+
+	return [_centerX, _centerY, _ringSize](const CTask& _task)
+	{
+		const float TWO_PI = 6.28318530718f;
+
+		float dx = _task.GetCenterX() - _centerX;
+		float dy = _task.GetCenterY() - _centerY;
+
+		//Which ring the tile is in, then how far around the ring it is [0, 1)
+		float ring = floorf(fmaxf(fabsf(dx), fabsf(dy)) / _ringSize + 0.5f);
+		float angle = atan2f(dy, dx);
+		if (angle < 0.0f)
+		{
+			angle += TWO_PI;
+		}
+		return ring + angle / TWO_PI;
+	};
+}
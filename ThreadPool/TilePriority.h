@@ -0,0 +1,36 @@
+#ifndef __TILEPRIORITY_H__
+#define __TILEPRIORITY_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	TilePriority.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	TilePriority
+// Description:
+//		Factory of priority functions for ThreadPool::SetPriorityFunction.
+//		Lower values are computed first.
+//
+
+//Library Includes
+#include <string>
+#include <functional>
+
+//Forward Declaration
+class CTask;
+
+typedef std::function<float(const CTask&)> PriorityFunction;
+
+class TilePriority
+{
+	//Static Functions:
+public:
+	static PriorityFunction DistanceFromPoint(float _x, float _y);
+	static PriorityFunction SpiralCenterOut(float _centerX, float _centerY, float _ringSize);
+
+private:
+	TilePriority();
+	~TilePriority();
+};
+
+#endif // !__TILEPRIORITY_H__
@@ -3,24 +3,63 @@
 #ifndef __WORKQUEUE_H__
 #define __WORKQUEUE_H__
 
-#include <queue>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 
+#include "WorkQueueADT.h"
+#include "SlotDeque.h"
 
 template<typename T>
-class CWorkQueue
+class CWorkQueue : public WorkQueueADT<T>
 {
 public:
 	CWorkQueue() {}
 
 	//Insert an item at the back of the queue and signal any thread that might be waiting for the q to be populated
-	void push(const T& item)
+	void push(T&& item)
 	{
 		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
-		workQ.push(std::move(item));
+		workQ.push_back(std::move(item));
 		m_WorkQCondition.notify_one();
 	}
 
+	//Insert _count items under one lock, then wake as many waiting threads as there are items.
+	void push_batch(T* _items, size_t _count)
+	{
+		if (_count == 0)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		for (size_t i = 0; i < _count; i++)
+		{
+			workQ.push_back(std::move(_items[i]));
+		}
+
+		if (_count == 1)
+		{
+			m_WorkQCondition.notify_one();
+		}
+		else
+		{
+			m_WorkQCondition.notify_all();
+		}
+	}
+
+	//Take up to _max items from the front of the queue under one lock.
+	size_t pop_batch(T* _workItems, size_t _max)
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		size_t count = 0;
+		while (count < _max && !workQ.empty())
+		{
+			workQ.pop_front(_workItems[count++]);
+		}
+		return count;
+	}
+
 	//Attempt to get a workitem from the queue
 	//If the Q is empty just return false; 
 	bool nonblocking_pop(T& _workItem)
@@ -31,8 +70,7 @@ public:
 		{
 			return false;
 		}
-		_workItem = std::move(workQ.front());
-		workQ.pop();
+		workQ.pop_front(_workItem);
 		return true;
 	}
 
@@ -47,12 +85,11 @@ public:
 			m_WorkQCondition.wait(_lock, [this] {return !workQ.empty(); });
 		}
 		// A retun value of false from wait_for means "timeout has elapsed".
-		if (!m_WorkQCondition.wait_for(_lock, std::chrono::milliseconds(time), [this] {return !workQ.empty(); }))
+		else if (!m_WorkQCondition.wait_for(_lock, std::chrono::milliseconds(time), [this] {return !workQ.empty(); }))
 		{
 			return false;
 		}
-		_workItem = std::move(workQ.front());
-		workQ.pop();
+		workQ.pop_front(_workItem);
 		return true;
 	}
 
@@ -63,9 +100,16 @@ public:
 		return workQ.empty();
 	}
 
+	//Number of items waiting in the queue
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> _lock(m_WorkQMutex);
+		return workQ.size();
+	}
+
 	
 private:
-	std::queue<T> workQ;
+	CSlotDeque<T> workQ;
 	mutable std::mutex m_WorkQMutex;
 	std::condition_variable m_WorkQCondition;
 
@@ -0,0 +1,82 @@
+#ifndef __WORKQUEUEADT_H__
+#define __WORKQUEUEADT_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	WorkQueueADT.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	WorkQueueADT (Abstract)
+// Description:
+//		An abstract data type for the work queues the ThreadPool can be
+//		configured with. Every queue shares the same push/pop contract.
+//		Items are moved in and out, so move-only types can be queued.
+//
+
+//Library Includes
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+template<typename T>
+class WorkQueueADT
+{
+public:
+	//Destructor
+	virtual ~WorkQueueADT() {};
+
+	//Abstract functions:
+	virtual void push(T&& item) = 0;
+	virtual bool nonblocking_pop(T& _workItem) = 0;
+	virtual bool blocking_pop(T& _workItem, unsigned int time = 0) = 0;
+	virtual bool empty() const = 0;
+	virtual size_t size() const = 0;
+
+	//Insert _count items in one go, moving them out of _items. Queues
+	//override this to take their lock once and wake sleeping workers with a
+	//single broadcast.
+	virtual void push_batch(T* _items, size_t _count)
+	{
+		for (size_t i = 0; i < _count; i++)
+		{
+			push(std::move(_items[i]));
+		}
+	}
+
+	//Insert an item only if there is room for it right now, the item is
+	//only moved from if it was taken. Unbounded queues always have room.
+	virtual bool try_push(T& item)
+	{
+		push(std::move(item));
+		return true;
+	}
+
+	//Take up to _max items without blocking, returns how many were taken.
+	virtual size_t pop_batch(T* _workItems, size_t _max)
+	{
+		size_t count = 0;
+		while (count < _max && nonblocking_pop(_workItems[count]))
+		{
+			count++;
+		}
+		return count;
+	}
+
+	//Tells the queue which worker slot the calling thread owns.
+	//Only queues with per-worker storage need to override this.
+	virtual void bind_worker(unsigned int _index) {};
+
+	//Steals tried and made by the worker at _index. Queues which don't
+	//steal report none.
+	virtual void get_steal_counts(unsigned int _index, uint64_t& _attempts, uint64_t& _steals) const
+	{
+		_attempts = 0;
+		_steals = 0;
+	}
+
+protected:
+	//Default Constructor
+	WorkQueueADT() {};
+};
+
+#endif // !__WORKQUEUEADT_H__
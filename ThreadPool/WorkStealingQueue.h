@@ -0,0 +1,324 @@
+#ifndef __WORKSTEALINGQUEUE_H__
+#define __WORKSTEALINGQUEUE_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	WorkStealingQueue.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	CWorkStealingQueue
+// Description:
+//		Work queue with one deque per worker. The owning worker pushes and pops
+//		the back of its own deque (LIFO), idle workers steal from the front of
+//		the other deques (FIFO), so workers only contend when they run dry.
+//
+
+//Library Includes
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+
+//Local Includes
+#include "WorkQueueADT.h"
+#include "SlotDeque.h"
+
+template<typename T>
+class CWorkStealingQueue : public WorkQueueADT<T>
+{
+public:
+	CWorkStealingQueue(unsigned int _workers)
+	{
+		m_uiSlotCount = (_workers > 0) ? _workers : 1;
+		m_pSlots = new Slot[m_uiSlotCount];
+	}
+
+	virtual ~CWorkStealingQueue()
+	{
+		delete[] m_pSlots;
+		m_pSlots = 0;
+	}
+
+	//Records that the calling thread owns the deque at _index.
+	virtual void bind_worker(unsigned int _index)
+	{
+		tl_pOwner = this;
+		tl_uiOwnerSlot = _index % m_uiSlotCount;
+	}
+
+	virtual void get_steal_counts(unsigned int _index, uint64_t& _attempts, uint64_t& _steals) const
+	{
+		const Slot& slot = m_pSlots[_index % m_uiSlotCount];
+		_attempts = slot.m_aulStealAttempts.load(std::memory_order_relaxed);
+		_steals = slot.m_aulSteals.load(std::memory_order_relaxed);
+	}
+
+	//Push onto the back of the caller's own deque. Threads which are not
+	//workers of this queue deal their items out round robin.
+	virtual void push(T&& item)
+	{
+		Slot& slot = m_pSlots[GetPushSlot()];
+		{
+			std::lock_guard<std::mutex> _lock(slot.m_mutex);
+			slot.m_items.push_back(std::move(item));
+		}
+		m_aiQueued++;
+
+		//Only touch the sleep mutex when someone is actually asleep
+		if (m_aiSleepers > 0)
+		{
+			std::lock_guard<std::mutex> _lock(m_sleepMutex);
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	//Workers push the whole batch onto their own deque for others to steal.
+	//Other threads split the batch into one contiguous run per deque.
+	virtual void push_batch(T* _items, size_t _count)
+	{
+		if (_count == 0)
+		{
+			return;
+		}
+
+		if (tl_pOwner == this)
+		{
+			Slot& own = m_pSlots[tl_uiOwnerSlot];
+			std::lock_guard<std::mutex> _lock(own.m_mutex);
+			for (size_t i = 0; i < _count; i++)
+			{
+				own.m_items.push_back(std::move(_items[i]));
+			}
+		}
+		else
+		{
+			size_t perSlot = (_count + m_uiSlotCount - 1) / m_uiSlotCount;
+			unsigned int first = m_uiNextPush++;
+			for (size_t start = 0, i = 0; start < _count; start += perSlot, i++)
+			{
+				size_t end = (start + perSlot < _count) ? start + perSlot : _count;
+				Slot& slot = m_pSlots[(first + i) % m_uiSlotCount];
+				std::lock_guard<std::mutex> _lock(slot.m_mutex);
+				for (size_t item = start; item < end; item++)
+				{
+					slot.m_items.push_back(std::move(_items[item]));
+				}
+			}
+		}
+		m_aiQueued += static_cast<int>(_count);
+
+		if (m_aiSleepers > 0)
+		{
+			std::lock_guard<std::mutex> _lock(m_sleepMutex);
+			m_sleepCondition.notify_all();
+		}
+	}
+
+	//Take up to _max items from the back of our own deque. When it is empty
+	//steal up to half of the first non-empty deque instead.
+	virtual size_t pop_batch(T* _workItems, size_t _max)
+	{
+		if (m_aiQueued <= 0 || _max == 0)
+		{
+			return 0;
+		}
+
+		unsigned int start = 0;
+		if (tl_pOwner == this)
+		{
+			start = tl_uiOwnerSlot;
+
+			Slot& own = m_pSlots[start];
+			std::lock_guard<std::mutex> _lock(own.m_mutex);
+			size_t count = 0;
+			while (count < _max && !own.m_items.empty())
+			{
+				own.m_items.pop_back(_workItems[count++]);
+			}
+			if (count > 0)
+			{
+				m_aiQueued -= static_cast<int>(count);
+				return count;
+			}
+		}
+		else
+		{
+			start = m_uiNextVictim++ % m_uiSlotCount;
+		}
+
+		for (unsigned int i = 1; i <= m_uiSlotCount; i++)
+		{
+			Slot& victim = m_pSlots[(start + i) % m_uiSlotCount];
+			std::lock_guard<std::mutex> _lock(victim.m_mutex);
+			size_t take = (victim.m_items.size() + 1) / 2;
+			if (take > _max)
+			{
+				take = _max;
+			}
+			for (size_t count = 0; count < take; count++)
+			{
+				victim.m_items.pop_front(_workItems[count]);
+			}
+			if (take > 0)
+			{
+				m_aiQueued -= static_cast<int>(take);
+				CountSteal(true);
+				return take;
+			}
+		}
+		CountSteal(false);
+		return 0;
+	}
+
+	//Pop from the back of our own deque, otherwise steal from the front of another.
+	virtual bool nonblocking_pop(T& _workItem)
+	{
+		if (m_aiQueued <= 0)
+		{
+			return false;
+		}
+
+		unsigned int start = 0;
+		if (tl_pOwner == this)
+		{
+			start = tl_uiOwnerSlot;
+
+			Slot& own = m_pSlots[start];
+			std::lock_guard<std::mutex> _lock(own.m_mutex);
+			if (!own.m_items.empty())
+			{
+				own.m_items.pop_back(_workItem);
+				m_aiQueued--;
+				return true;
+			}
+		}
+		else
+		{
+			start = m_uiNextVictim++ % m_uiSlotCount;
+		}
+		return Steal(_workItem, start);
+	}
+
+	//Attempt to get a workitem from the queue
+	//If every deque is empty block the thread until a notification is sent to it.
+	virtual bool blocking_pop(T& _workItem, unsigned int time = 0)
+	{
+		while (!nonblocking_pop(_workItem))
+		{
+			std::unique_lock<std::mutex> _lock(m_sleepMutex);
+			m_aiSleepers++;
+			bool hasWork = true;
+			if (time == 0)
+			{
+				m_sleepCondition.wait(_lock, [this] {return m_aiQueued > 0; });
+			}
+			else
+			{
+				hasWork = m_sleepCondition.wait_for(_lock, std::chrono::milliseconds(time), [this] {return m_aiQueued > 0; });
+			}
+			m_aiSleepers--;
+
+			// A retun value of false from wait_for means "timeout has elapsed".
+			if (!hasWork)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Checking if every deque is empty or not
+	virtual bool empty() const
+	{
+		return m_aiQueued <= 0;
+	}
+
+	//Number of items across every deque
+	virtual size_t size() const
+	{
+		int queued = m_aiQueued;
+		return (queued > 0) ? static_cast<size_t>(queued) : 0;
+	}
+
+protected:
+	//Walk the other deques once, taking the oldest item from the first non-empty one.
+	bool Steal(T& _workItem, unsigned int _start)
+	{
+		for (unsigned int i = 1; i <= m_uiSlotCount; i++)
+		{
+			Slot& victim = m_pSlots[(_start + i) % m_uiSlotCount];
+			std::lock_guard<std::mutex> _lock(victim.m_mutex);
+			if (!victim.m_items.empty())
+			{
+				victim.m_items.pop_front(_workItem);
+				m_aiQueued--;
+				CountSteal(true);
+				return true;
+			}
+		}
+		CountSteal(false);
+		return false;
+	}
+
+	//Only the owner of a deque writes its counts, so no read-modify-write is needed
+	void CountSteal(bool _stolen)
+	{
+		if (tl_pOwner != this)
+		{
+			return;
+		}
+		Slot& own = m_pSlots[tl_uiOwnerSlot];
+		own.m_aulStealAttempts.store(own.m_aulStealAttempts.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		if (_stolen)
+		{
+			own.m_aulSteals.store(own.m_aulSteals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+
+	unsigned int GetPushSlot()
+	{
+		if (tl_pOwner == this)
+		{
+			return tl_uiOwnerSlot;
+		}
+		return m_uiNextPush++ % m_uiSlotCount;
+	}
+
+private:
+	//One deque per worker, padded so neighbouring locks don't share a cache line.
+	struct Slot
+	{
+		std::mutex m_mutex;
+		CSlotDeque<T> m_items;
+
+		//Steals tried and made by the worker owning this deque
+		std::atomic<uint64_t> m_aulStealAttempts{ 0 };
+		std::atomic<uint64_t> m_aulSteals{ 0 };
+		char m_padding[64];
+	};
+
+	Slot* m_pSlots;
+	unsigned int m_uiSlotCount;
+
+	std::atomic_uint m_uiNextPush{ 0 };
+	std::atomic_uint m_uiNextVictim{ 0 };
+
+	//Total items across all deques, used to put idle workers to sleep.
+	std::atomic_int m_aiQueued{ 0 };
+	std::atomic_int m_aiSleepers{ 0 };
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+
+	//Which queue/slot the calling thread is a worker of.
+	static thread_local CWorkStealingQueue<T>* tl_pOwner;
+	static thread_local unsigned int tl_uiOwnerSlot;
+};
+
+template<typename T>
+thread_local CWorkStealingQueue<T>* CWorkStealingQueue<T>::tl_pOwner = nullptr;
+
+template<typename T>
+thread_local unsigned int CWorkStealingQueue<T>::tl_uiOwnerSlot = 0;
+
+#endif // !__WORKSTEALINGQUEUE_H__
@@ -0,0 +1,200 @@
+//
+// (c) 2026 agent
+//
+// File Name    |	WorkerStats.cpp
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	WorkerStats, PoolStats, CWorkerCounters
+// Description:
+//		Per worker load counters for the ThreadPool. Each worker adds to its
+//		own cache line of counters, the pool reads them all into a PoolStats
+//		snapshot to show how evenly the work was spread.
+//
+
+//Self Include
+#include "WorkerStats.h"
+
+//Library Includes
+#include <iostream>
+#include <iomanip>
+
+//Add Assignment
+WorkerStats& WorkerStats::operator+=(const WorkerStats& _other)
+{
+	m_ulTasks += _other.m_ulTasks;
+	m_ulDropped += _other.m_ulDropped;
+	m_ulBusyNs += _other.m_ulBusyNs;
+	m_ulIdleNs += _other.m_ulIdleNs;
+	m_ulQueueWaitNs += _other.m_ulQueueWaitNs;
+	m_ulPixels += _other.m_ulPixels;
+	m_ulIterations += _other.m_ulIterations;
+	m_ulStealAttempts += _other.m_ulStealAttempts;
+	m_ulSteals += _other.m_ulSteals;
+	return *this;
+}
+
+//Subtract Assignment
+WorkerStats& WorkerStats::operator-=(const WorkerStats& _other)
+{
+	m_ulTasks -= _other.m_ulTasks;
+	m_ulDropped -= _other.m_ulDropped;
+	m_ulBusyNs -= _other.m_ulBusyNs;
+	m_ulIdleNs -= _other.m_ulIdleNs;
+	m_ulQueueWaitNs -= _other.m_ulQueueWaitNs;
+	m_ulPixels -= _other.m_ulPixels;
+	m_ulIterations -= _other.m_ulIterations;
+	m_ulStealAttempts -= _other.m_ulStealAttempts;
+	m_ulSteals -= _other.m_ulSteals;
+	return *this;
+}
+
+//	GetTotal( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Adds up the stats of every worker.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: WorkerStats	|	Sum over all workers.
+//
+WorkerStats PoolStats::GetTotal() const
+{
+	WorkerStats total;
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		total += m_workers[i];
+	}
+	return total;
+}
+
+//	GetImbalance( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Busy time of the busiest worker over the mean busy time. 1.0 means
+//		the work was spread perfectly, 2.0 that one worker did twice its share.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: double	|	Load imbalance, 1.0 if nothing ran.
+//
+double PoolStats::GetImbalance() const
+{
+	if (m_workers.empty())
+	{
+		return 1.0;
+	}
+
+	uint64_t busiest = 0;
+	uint64_t total = 0;
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		busiest = (m_workers[i].m_ulBusyNs > busiest) ? m_workers[i].m_ulBusyNs : busiest;
+		total += m_workers[i].m_ulBusyNs;
+	}
+
+	double mean = static_cast<double>(total) / m_workers.size();
+	return (mean > 0.0) ? busiest / mean : 1.0;
+}
+
+//	Print( _prefix )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Prints one line per worker and a summary line to the console.
+//
+//	Param:
+//		- std::string	|	Tag at the start of each line, e.g. "MAIN THREAD".
+//
+//	Return: n/a		|
+//
+void PoolStats::Print(const std::string& _prefix) const
+{
+	std::cout << "[" << _prefix << "]: " << std::setw(8) << "Worker" << std::setw(8) << "Tasks" << std::setw(10) << "Busy ms" << std::setw(10) << "Idle ms";
+	std::cout << std::setw(12) << "Wait us" << std::setw(10) << "Pixels" << std::setw(12) << "Iterations" << std::setw(10) << "Steals" << std::endl;
+
+	//Put the stream back afterwards, so later output isn't left fixed point
+	std::ios::fmtflags flags = std::cout.flags();
+	std::streamsize precision = std::cout.precision();
+
+	std::cout << std::fixed;
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		const WorkerStats& w = m_workers[i];
+		double wait = (w.m_ulTasks > 0) ? (w.m_ulQueueWaitNs / 1000.0) / w.m_ulTasks : 0.0;
+
+		std::cout << "[" << _prefix << "]: " << std::setw(8) << i << std::setw(8) << w.m_ulTasks;
+		std::cout << std::setprecision(2) << std::setw(10) << w.m_ulBusyNs / 1000000.0 << std::setw(10) << w.m_ulIdleNs / 1000000.0;
+		std::cout << std::setprecision(1) << std::setw(12) << wait << std::setw(10) << w.m_ulPixels << std::setw(12) << w.m_ulIterations;
+		std::cout << std::setw(10) << (std::to_string(w.m_ulSteals) + "/" + std::to_string(w.m_ulStealAttempts)) << std::endl;
+	}
+
+	WorkerStats total = GetTotal();
+	double busy = (m_ulElapsedNs > 0 && !m_workers.empty()) ? (100.0 * total.m_ulBusyNs) / (static_cast<double>(m_ulElapsedNs) * m_workers.size()) : 0.0;
+	std::cout << "[" << _prefix << "]: " << std::setprecision(2) << "Imbalance " << GetImbalance() << "x, workers busy " << std::setprecision(1) << busy << "% of ";
+	std::cout << std::setprecision(2) << m_ulElapsedNs / 1000000.0 << " ms, " << total.m_ulDropped << " tasks dropped, deepest queue " << m_iQueueHighWater << " tasks, ";
+	std::cout << m_ulBlockedSubmits << " submits waited for room, " << m_ulHelpedTasks << " tasks run by waiting threads." << std::endl;
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+}
+
+//	ReadTicks( )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Reads the counters as they are. Safe to call while the owner is still
+//		adding to them.
+//
+//	Param:
+//		- n/a	|
+//
+//	Return: WorkerTicks	|	Counters so far, times in timestamp ticks.
+//
+WorkerTicks CWorkerCounters::ReadTicks() const
+{
+	WorkerTicks ticks;
+	ticks.m_ulTasks = m_aulTasks.load(std::memory_order_relaxed);
+	ticks.m_ulDropped = m_aulDropped.load(std::memory_order_relaxed);
+	ticks.m_ulBusyTicks = m_aulBusyTicks.load(std::memory_order_relaxed);
+	ticks.m_ulIdleTicks = m_aulIdleTicks.load(std::memory_order_relaxed);
+	ticks.m_ulQueueWaitTicks = m_aulQueueWaitTicks.load(std::memory_order_relaxed);
+	ticks.m_ulPixels = m_aulPixels.load(std::memory_order_relaxed);
+	ticks.m_ulIterations = m_aulIterations.load(std::memory_order_relaxed);
+	return ticks;
+}
+
+//	Read( _since, _ticksPerMicrosecond )
+//
+//	Author: agent
+//	Access: public
+//	Description:
+//		Reads how much the counters have grown since a ReadTicks baseline,
+//		converting the times to nanoseconds.
+//
+//	Param:
+//		- WorkerTicks&	|	Baseline from ReadTicks.
+//		- double		|	Timestamp ticks per microsecond.
+//
+//	Return: WorkerStats	|	Counters since the baseline. Steals are filled in by the pool.
+//
+WorkerStats CWorkerCounters::Read(const WorkerTicks& _since, double _ticksPerMicrosecond) const
+{
+	double nsPerTick = (_ticksPerMicrosecond > 0.0) ? 1000.0 / _ticksPerMicrosecond : 1.0;
+	WorkerTicks now = ReadTicks();
+
+	WorkerStats stats;
+	stats.m_ulTasks = now.m_ulTasks - _since.m_ulTasks;
+	stats.m_ulDropped = now.m_ulDropped - _since.m_ulDropped;
+	stats.m_ulBusyNs = static_cast<uint64_t>((now.m_ulBusyTicks - _since.m_ulBusyTicks) * nsPerTick);
+	stats.m_ulIdleNs = static_cast<uint64_t>((now.m_ulIdleTicks - _since.m_ulIdleTicks) * nsPerTick);
+	stats.m_ulQueueWaitNs = static_cast<uint64_t>((now.m_ulQueueWaitTicks - _since.m_ulQueueWaitTicks) * nsPerTick);
+	stats.m_ulPixels = now.m_ulPixels - _since.m_ulPixels;
+	stats.m_ulIterations = now.m_ulIterations - _since.m_ulIterations;
+	return stats;
+}
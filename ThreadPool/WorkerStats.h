@@ -0,0 +1,94 @@
+#ifndef __WORKERSTATS_H__
+#define __WORKERSTATS_H__
+
+//
+// (c) 2026 agent
+//
+// File Name    |	WorkerStats.h
+// Author(s)    |	agent (agent@local)
+// Class(es)	|	WorkerStats, PoolStats, CWorkerCounters
+// Description:
+//		Per worker load counters for the ThreadPool. Each worker adds to its
+//		own cache line of counters, the pool reads them all into a PoolStats
+//		snapshot to show how evenly the work was spread.
+//
+
+//Library Includes
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Totals for one worker since the stats were last reset, times are in nanoseconds
+struct WorkerStats
+{
+	uint64_t m_ulTasks = 0;
+	uint64_t m_ulDropped = 0;
+	uint64_t m_ulBusyNs = 0;
+	uint64_t m_ulIdleNs = 0;
+	uint64_t m_ulQueueWaitNs = 0;
+	uint64_t m_ulPixels = 0;
+	uint64_t m_ulIterations = 0;
+	uint64_t m_ulStealAttempts = 0;
+	uint64_t m_ulSteals = 0;
+
+	WorkerStats& operator+=(const WorkerStats& _other);
+	WorkerStats& operator-=(const WorkerStats& _other);
+};
+
+//Raw counters of one worker at some point, times in timestamp ticks. Only
+//a baseline for CWorkerCounters::Read, kept apart so ticks can't be taken
+//for nanoseconds.
+struct WorkerTicks
+{
+	uint64_t m_ulTasks = 0;
+	uint64_t m_ulDropped = 0;
+	uint64_t m_ulBusyTicks = 0;
+	uint64_t m_ulIdleTicks = 0;
+	uint64_t m_ulQueueWaitTicks = 0;
+	uint64_t m_ulPixels = 0;
+	uint64_t m_ulIterations = 0;
+	uint64_t m_ulStealAttempts = 0;
+	uint64_t m_ulSteals = 0;
+};
+
+//Every worker plus the queue, see ThreadPool::GetStats
+struct PoolStats
+{
+	std::vector<WorkerStats> m_workers;
+	uint64_t m_ulElapsedNs = 0;
+	int m_iQueueHighWater = 0;
+	uint64_t m_ulBlockedSubmits = 0;
+
+	//Run by threads outside the pool while they waited, not in any worker
+	uint64_t m_ulHelpedTasks = 0;
+
+	WorkerStats GetTotal() const;
+	double GetImbalance() const;
+	void Print(const std::string& _prefix) const;
+};
+
+//Live counters of one worker, in timestamp ticks. Only the owning worker
+//writes them, so adding is a load and a store rather than a locked add.
+class alignas(64) CWorkerCounters
+{
+public:
+	static void Add(std::atomic<uint64_t>& _counter, uint64_t _amount)
+	{
+		_counter.store(_counter.load(std::memory_order_relaxed) + _amount, std::memory_order_relaxed);
+	};
+
+	//Times are left in ticks, for a baseline to pass to Read later
+	WorkerTicks ReadTicks() const;
+	WorkerStats Read(const WorkerTicks& _since, double _ticksPerMicrosecond) const;
+
+	std::atomic<uint64_t> m_aulTasks{ 0 };
+	std::atomic<uint64_t> m_aulDropped{ 0 };
+	std::atomic<uint64_t> m_aulBusyTicks{ 0 };
+	std::atomic<uint64_t> m_aulIdleTicks{ 0 };
+	std::atomic<uint64_t> m_aulQueueWaitTicks{ 0 };
+	std::atomic<uint64_t> m_aulPixels{ 0 };
+	std::atomic<uint64_t> m_aulIterations{ 0 };
+};
+
+#endif // !__WORKERSTATS_H__
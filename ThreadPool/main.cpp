@@ -4,6 +4,8 @@
 
 //Library Includes
 #include <iostream>
+#include <string>
+#include <cstdlib>
 //#include <vld.h>
 
 #include "ThreadPool.h"
@@ -14,6 +16,7 @@
 #include "Renderer.h"
 #include "InputHandler.h"
 #include "iniParser.h"
+#include "Benchmark.h"
 
 //Close everything
 void ShutDown()
@@ -26,6 +29,26 @@ void ShutDown()
 	IniParser::DestroyInstance();
 }
 
+//Times the executor backends, tile sizes and schedules on the starting view without opening a
+//window, and checks warmed up frames make no task heap allocations
+int RunBenchmark(unsigned int _frames)
+{
+	ThreadPool::GetInstance().Initialize();
+	ThreadPool::GetInstance().Start();
+
+	RenderJob view(Renderer::SCREEN_WIDTH, Renderer::SCREEN_HEIGHT, IniParser::GetInstance().GetValueAsInt("Tread", "IterateLimit"));
+	view.FitView(static_cast<float>(Renderer::SCREEN_WIDTH), static_cast<float>(Renderer::SCREEN_HEIGHT), 1.0f, 0.0f, 0.0f);
+	int divisions = IniParser::GetInstance().GetValueAsInt("Tread", "WorkDivisionsCount");
+	bool passed = Benchmark::RunExecutors(view, divisions, _frames);
+	passed = Benchmark::RunTileSizes(view, divisions, _frames) && passed;
+	passed = Benchmark::RunCostMap(view, divisions, _frames) && passed;
+	passed = Benchmark::RunAllocations(view, divisions, _frames) && passed;
+
+	ThreadPool::DestroyInstance();
+	IniParser::DestroyInstance();
+	return passed ? 0 : 1;
+}
+
 //Force size of the window
 void Resize(int width, int height)
 {
@@ -41,6 +64,12 @@ int main(int argc, char** argv)
 	Renderer::SCREEN_WIDTH = IniParser::GetInstance().GetValueAsInt("Window", "Size");
 	Renderer::SCREEN_HEIGHT = IniParser::GetInstance().GetValueAsInt("Window", "Size");
 
+	//ThreadPool.exe -benchmark [frames]
+	if (argc > 1 && std::string(argv[1]) == "-benchmark")
+	{
+		return RunBenchmark((argc > 2) ? std::atoi(argv[2]) : 10);
+	}
+
 	//Start openGl
 	glutInit(&argc, argv);
 	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);